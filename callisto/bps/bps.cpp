@@ -0,0 +1,568 @@
+#include "bps.h"
+
+namespace callisto {
+	uint8_t Bps::Reader::readByte() {
+		if (offset >= end) {
+			throw BpsException("BPS patch ends unexpectedly");
+		}
+		return static_cast<uint8_t>(patch[offset++]);
+	}
+
+	uint64_t Bps::Reader::readNumber() {
+		uint64_t data{ 0 };
+		uint64_t shift{ 1 };
+		while (true) {
+			const auto byte{ readByte() };
+			data += (byte & 0x7F) * shift;
+			if (byte & 0x80) {
+				return data;
+			}
+			shift <<= 7;
+			data += shift;
+
+			if (shift > (uint64_t{ 1 } << 56)) {
+				throw BpsException("BPS patch contains a number that is too large");
+			}
+		}
+	}
+
+	const char* Bps::Reader::readBytes(size_t count) {
+		if (end - offset < count) {
+			throw BpsException("BPS patch ends unexpectedly");
+		}
+		const auto bytes{ patch.data() + offset };
+		offset += count;
+		return bytes;
+	}
+
+	uint32_t Bps::readCrc(const std::vector<char>& data, size_t offset) {
+		uint32_t crc{ 0 };
+		for (size_t i{ 0 }; i != 4; ++i) {
+			crc |= static_cast<uint32_t>(static_cast<uint8_t>(data[offset + i])) << (8 * i);
+		}
+		return crc;
+	}
+
+	void Bps::addChangedRange(std::vector<std::pair<size_t, size_t>>& ranges, size_t offset, size_t size) {
+		if (!ranges.empty() && ranges.back().first + ranges.back().second == offset) {
+			ranges.back().second += size;
+		}
+		else {
+			ranges.emplace_back(offset, size);
+		}
+	}
+
+	Bps::Result Bps::apply(const std::vector<char>& patch, const std::vector<char>& source) {
+		if (patch.size() < sizeof(MAGIC) + FOOTER_SIZE || !std::equal(std::begin(MAGIC), std::end(MAGIC), patch.begin())) {
+			throw BpsException("Not a BPS patch");
+		}
+
+		const auto footer_offset{ patch.size() - FOOTER_SIZE };
+		if (HashUtil::crc32(patch.data(), patch.size() - 4) != readCrc(patch, footer_offset + 8)) {
+			throw BpsException("BPS patch is corrupted, its checksum does not match");
+		}
+
+		Reader reader{ patch, footer_offset };
+		reader.readBytes(sizeof(MAGIC));
+		const auto source_size{ reader.readNumber() };
+		const auto target_size{ reader.readNumber() };
+		reader.readBytes(reader.readNumber());
+
+		// FLIPS does the same, patches are made against unheadered ROMs
+		size_t header_size{ 0 };
+		if (source.size() == source_size + COPIER_HEADER_SIZE) {
+			header_size = COPIER_HEADER_SIZE;
+		}
+		else if (source.size() != source_size) {
+			throw BpsException(fmt::format("BPS patch expects a source of {} bytes, got {} bytes", source_size, source.size()));
+		}
+
+		const auto* const source_data{ source.data() + header_size };
+		if (HashUtil::crc32(source_data, source_size) != readCrc(patch, footer_offset)) {
+			throw BpsException("BPS patch does not belong to this source, its checksum does not match");
+		}
+
+		Result result{};
+		result.target.resize(header_size + target_size);
+		std::copy(source.begin(), source.begin() + header_size, result.target.begin());
+		auto* const target_data{ result.target.data() + header_size };
+
+		size_t output_offset{ 0 };
+		int64_t source_relative_offset{ 0 };
+		int64_t target_relative_offset{ 0 };
+
+		while (!reader.done()) {
+			const auto data{ reader.readNumber() };
+			const auto action{ static_cast<Action>(data & 3) };
+			const size_t length{ (data >> 2) + 1 };
+
+			if (target_size - output_offset < length) {
+				throw BpsException("BPS patch writes past the end of its target");
+			}
+
+			switch (action) {
+			case Action::SOURCE_READ:
+				if (output_offset + length > source_size) {
+					throw BpsException("BPS patch reads past the end of its source");
+				}
+				std::copy(source_data + output_offset, source_data + output_offset + length, target_data + output_offset);
+				break;
+
+			case Action::TARGET_READ: {
+				const auto bytes{ reader.readBytes(length) };
+				std::copy(bytes, bytes + length, target_data + output_offset);
+				break;
+			}
+
+			case Action::SOURCE_COPY:
+			case Action::TARGET_COPY: {
+				const auto offset_data{ reader.readNumber() };
+				const auto delta{ static_cast<int64_t>(offset_data >> 1) * ((offset_data & 1) ? -1 : 1) };
+				auto& relative_offset{ action == Action::SOURCE_COPY ? source_relative_offset : target_relative_offset };
+				relative_offset += delta;
+
+				if (action == Action::SOURCE_COPY) {
+					if (relative_offset < 0 || static_cast<uint64_t>(relative_offset) + length > source_size) {
+						throw BpsException("BPS patch copies from outside of its source");
+					}
+					std::copy(source_data + relative_offset, source_data + relative_offset + length, target_data + output_offset);
+				}
+				else {
+					if (relative_offset < 0 || static_cast<uint64_t>(relative_offset) >= output_offset) {
+						throw BpsException("BPS patch copies from outside of its target");
+					}
+					// source and destination may overlap to repeat a pattern, so this has to go byte by byte
+					for (size_t i{ 0 }; i != length; ++i) {
+						target_data[output_offset + i] = target_data[relative_offset + i];
+					}
+				}
+				relative_offset += length;
+				break;
+			}
+			}
+
+			output_offset += length;
+		}
+
+		if (output_offset != target_size) {
+			throw BpsException("BPS patch does not fill its entire target");
+		}
+
+		if (HashUtil::crc32(target_data, target_size) != readCrc(patch, footer_offset + 4)) {
+			throw BpsException("Result of applying BPS patch does not match the checksum stored in the patch");
+		}
+
+		// compared separately so the ranges cover what actually changed, no matter which actions wrote it
+		const auto compared_size{ std::min<size_t>(source_size, target_size) };
+		size_t offset{ 0 };
+		while (offset != compared_size) {
+			const auto mismatch{ std::mismatch(source_data + offset, source_data + compared_size, target_data + offset) };
+			offset = mismatch.first - source_data;
+			if (offset == compared_size) {
+				break;
+			}
+			const auto run_end{ std::mismatch(source_data + offset, source_data + compared_size, target_data + offset, 
+				[](char a, char b) { return a != b; }).first - source_data };
+			addChangedRange(result.changed_ranges, header_size + offset, run_end - offset);
+			offset = run_end;
+		}
+		if (target_size > source_size) {
+			addChangedRange(result.changed_ranges, header_size + source_size, target_size - source_size);
+		}
+
+		return result;
+	}
+
+	Bps::Result Bps::applyFile(const fs::path& patch_path, const fs::path& source_path, const fs::path& target_path) {
+		auto result{ apply(FileUtil::readAll(patch_path), FileUtil::readAll(source_path)) };
+
+		std::ofstream target{ target_path, std::ios::out | std::ios::binary };
+		target.write(result.target.data(), result.target.size());
+		target.close();
+		if (!target) {
+			throw BpsException(fmt::format("Failed to write patched ROM to {}", target_path.string()));
+		}
+
+		return result;
+	}
+
+	Bps::Index::Index(const char* data, size_t data_size, size_t key_size)
+		: data(data), data_size(data_size), key_size(key_size), 
+		hash_bits(std::clamp<size_t>(std::bit_width(data_size), 10, 22)) {
+		const size_t bucket_count{ size_t{ 1 } << hash_bits };
+		bucket_starts.resize(bucket_count + 1, 0);
+		if (data_size < key_size) {
+			return;
+		}
+
+		const auto position_count{ data_size - key_size + 1 };
+		const auto chunk_count{ (position_count + CREATE_CHUNK_SIZE - 1) / CREATE_CHUNK_SIZE };
+
+		// every slice owns a contiguous range of buckets picked by the top bits of the hash, so slices never 
+		// write to the same place, a few more slices than threads keeps them busy if buckets are uneven
+		const auto slice_bits{ std::min<size_t>(hash_bits, 
+			std::bit_width(std::bit_ceil(std::max<size_t>(1, globals::MAX_THREAD_COUNT * 4))) - 1) };
+		const size_t slice_count{ size_t{ 1 } << slice_bits };
+		const auto bucket_shift{ hash_bits - slice_bits };
+
+		// sorts every chunk's positions by slice while hashing, so each slice only has to look at its own positions
+		std::vector<uint32_t> hashes(position_count);
+		std::vector<std::vector<std::vector<uint32_t>>> chunk_slices(chunk_count, std::vector<std::vector<uint32_t>>(slice_count));
+		Scheduler::forEach(chunk_count, [&](size_t chunk) {
+			auto& slices{ chunk_slices[chunk] };
+			const auto begin{ chunk * CREATE_CHUNK_SIZE };
+			const auto end{ std::min(position_count, begin + CREATE_CHUNK_SIZE) };
+			for (size_t position{ begin }; position != end; ++position) {
+				const auto hash{ hashAt(data + position) };
+				hashes[position] = hash;
+				slices[hash >> bucket_shift].push_back(static_cast<uint32_t>(position));
+			}
+		});
+
+		Scheduler::forEach(slice_count, [&](size_t slice) {
+			for (const auto& slices : chunk_slices) {
+				for (const auto position : slices[slice]) {
+					++bucket_starts[hashes[position] + 1];
+				}
+			}
+		});
+
+		for (size_t bucket{ 0 }; bucket != bucket_count; ++bucket) {
+			bucket_starts[bucket + 1] += bucket_starts[bucket];
+		}
+
+		// chunks are visited in order and positions within a chunk are ascending, so buckets end up sorted
+		positions.resize(position_count);
+		Scheduler::forEach(slice_count, [&](size_t slice) {
+			const auto first_bucket{ slice << bucket_shift };
+			std::vector<uint32_t> cursors(bucket_starts.begin() + first_bucket, 
+				bucket_starts.begin() + first_bucket + (size_t{ 1 } << bucket_shift));
+			for (const auto& slices : chunk_slices) {
+				for (const auto position : slices[slice]) {
+					positions[cursors[hashes[position] - first_bucket]++] = position;
+				}
+			}
+		});
+	}
+
+	uint32_t Bps::Index::hashAt(const char* bytes) const {
+		uint64_t key{ 0 };
+		for (size_t i{ 0 }; i != key_size; ++i) {
+			key |= static_cast<uint64_t>(static_cast<uint8_t>(bytes[i])) << (8 * i);
+		}
+		return static_cast<uint32_t>((key * 0x9E3779B185EBCA87ULL) >> (64 - hash_bits));
+	}
+
+	std::pair<const uint32_t*, const uint32_t*> Bps::Index::bucket(const char* bytes) const {
+		if (positions.empty()) {
+			return { nullptr, nullptr };
+		}
+		const auto hash{ hashAt(bytes) };
+		return { positions.data() + bucket_starts[hash], positions.data() + bucket_starts[hash + 1] };
+	}
+
+	Bps::Parameters Bps::getParameters(Effort effort) {
+		switch (effort) {
+		case Effort::FAST:
+			return { 8, 4, 32, false };
+		case Effort::SMALL:
+			// 4 byte keys mostly found short matches that broke up literal runs and made patches bigger than FAST's
+			return { 5, 256, 512, true };
+		case Effort::BALANCED:
+		default:
+			return { 6, 32, 128, true };
+		}
+	}
+
+	Bps::Effort Bps::parseEffort(std::string_view effort) {
+		if (effort == "fast") {
+			return Effort::FAST;
+		}
+		else if (effort == "balanced") {
+			return Effort::BALANCED;
+		}
+		else if (effort == "small") {
+			return Effort::SMALL;
+		}
+		else {
+			throw BpsException(fmt::format(
+				"Unknown BPS effort '{}', expected 'fast', 'balanced' or 'small'",
+				effort
+			));
+		}
+	}
+
+	size_t Bps::getCopierHeaderSize(size_t size) {
+		// ROMs come in multiples of 32KB, so anything 512 bytes past that has a copier header
+		return size % 0x8000 == COPIER_HEADER_SIZE ? COPIER_HEADER_SIZE : 0;
+	}
+
+	size_t Bps::numberSize(uint64_t number) {
+		size_t size{ 1 };
+		while (number >= 0x80) {
+			number = (number >> 7) - 1;
+			++size;
+		}
+		return size;
+	}
+
+	void Bps::writeNumber(std::vector<char>& patch, uint64_t number) {
+		while (true) {
+			const auto low_bits{ static_cast<char>(number & 0x7F) };
+			number >>= 7;
+			if (number == 0) {
+				patch.push_back(static_cast<char>(0x80 | low_bits));
+				return;
+			}
+			patch.push_back(low_bits);
+			--number;
+		}
+	}
+
+	void Bps::writeCrc(std::vector<char>& patch, uint32_t crc) {
+		for (size_t i{ 0 }; i != 4; ++i) {
+			patch.push_back(static_cast<char>((crc >> (8 * i)) & 0xFF));
+		}
+	}
+
+	uint64_t Bps::encodeOffset(int64_t delta) {
+		return (static_cast<uint64_t>(delta < 0 ? -delta : delta) << 1) | (delta < 0 ? 1 : 0);
+	}
+
+	Bps::Match Bps::findMatch(const Inputs& inputs, size_t position, size_t limit,
+		size_t source_relative_offset, size_t target_relative_offset, bool literal_pending) {
+		const auto& parameters{ inputs.parameters };
+		const auto* const target_position{ inputs.target + position };
+		const auto max_length{ limit - position };
+
+		// storing the bytes as a TARGET_READ instead needs one more byte to start a new run unless one is already going
+		const auto benefitOf{ [&](size_t length, Action action, uint64_t encoded_offset) {
+			auto cost{ numberSize(((static_cast<uint64_t>(length) - 1) << 2) | static_cast<uint64_t>(action)) };
+			if (action == Action::SOURCE_COPY || action == Action::TARGET_COPY) {
+				cost += numberSize(encoded_offset);
+			}
+			return static_cast<int64_t>(length + (literal_pending ? 0 : 1)) - static_cast<int64_t>(cost);
+		} };
+
+		Match best{ { Action::TARGET_READ, 0 }, 0 };
+		const auto consider{ [&](Action action, size_t length, size_t offset, uint64_t encoded_offset) {
+			const auto benefit{ benefitOf(length, action, encoded_offset) };
+			if (benefit > best.benefit) {
+				best = { { action, length, offset }, benefit };
+			}
+		} };
+
+		if (position < inputs.source_size) {
+			const auto compared{ std::min(max_length, inputs.source_size - position) };
+			const auto length{ static_cast<size_t>(std::mismatch(target_position, target_position + compared,
+				inputs.source + position).first - target_position) };
+			if (length != 0) {
+				consider(Action::SOURCE_READ, length, 0, 0);
+			}
+			if (length >= parameters.nice_length || length == max_length) {
+				return best;
+			}
+		}
+
+		if (position + parameters.key_size > inputs.target_size) {
+			return best;
+		}
+
+		// source candidates closest to where we are first, data that moved usually didn't move far
+		const auto [source_begin, source_end] { inputs.source_index.bucket(target_position) };
+		if (source_begin != source_end) {
+			auto below{ std::lower_bound(source_begin, source_end, static_cast<uint32_t>(position)) };
+			auto above{ below };
+			for (size_t examined{ 0 }; examined < parameters.max_candidates && (below != source_begin || above != source_end); ++examined) {
+				size_t candidate;
+				if (above == source_end || (below != source_begin && examined % 2 == 0)) {
+					candidate = *--below;
+				}
+				else {
+					candidate = *above++;
+				}
+
+				const auto compared{ std::min(max_length, inputs.source_size - candidate) };
+				const auto length{ static_cast<size_t>(std::mismatch(target_position, target_position + compared,
+					inputs.source + candidate).first - target_position) };
+				if (length >= parameters.key_size) {
+					consider(Action::SOURCE_COPY, length, candidate, 
+						encodeOffset(static_cast<int64_t>(candidate) - static_cast<int64_t>(source_relative_offset)));
+					if (length == max_length) {
+						return best;
+					}
+				}
+			}
+		}
+
+		// only earlier target positions can be copied from, nearest first since those tend to be cheapest to encode
+		const auto [target_begin, target_end] { inputs.target_index.bucket(target_position) };
+		if (target_begin != target_end) {
+			auto current{ std::lower_bound(target_begin, target_end, static_cast<uint32_t>(position)) };
+			for (size_t examined{ 0 }; examined < parameters.max_candidates && current != target_begin; ++examined) {
+				const size_t candidate{ *--current };
+				// may run into the bytes being produced, the patcher copies byte by byte so that repeats a pattern
+				size_t length{ 0 };
+				while (length != max_length && inputs.target[candidate + length] == target_position[length]) {
+					++length;
+				}
+				if (length >= parameters.key_size) {
+					consider(Action::TARGET_COPY, length, candidate,
+						encodeOffset(static_cast<int64_t>(candidate) - static_cast<int64_t>(target_relative_offset)));
+					if (length == max_length) {
+						return best;
+					}
+				}
+			}
+		}
+
+		return best;
+	}
+
+	std::vector<Bps::Operation> Bps::matchChunk(const Inputs& inputs, size_t chunk_start, size_t chunk_end) {
+		std::vector<Operation> operations{};
+		// only estimates until the chunks are joined, good enough for weighing offsets against each other
+		size_t source_relative_offset{ chunk_start };
+		size_t target_relative_offset{ chunk_start };
+
+		const auto addLiteral{ [&] {
+			if (!operations.empty() && operations.back().action == Action::TARGET_READ) {
+				++operations.back().length;
+			}
+			else {
+				operations.push_back({ Action::TARGET_READ, 1 });
+			}
+		} };
+		const auto literalPending{ [&] {
+			return !operations.empty() && operations.back().action == Action::TARGET_READ;
+		} };
+
+		std::optional<Match> next_match{};
+		size_t position{ chunk_start };
+		while (position != chunk_end) {
+			const auto match{ next_match.has_value() ? *next_match : findMatch(inputs, position, chunk_end,
+				source_relative_offset, target_relative_offset, literalPending()) };
+			next_match.reset();
+
+			if (match.operation.length == 0) {
+				addLiteral();
+				++position;
+				continue;
+			}
+
+			if (inputs.parameters.lazy_matching && match.operation.length < inputs.parameters.nice_length && position + 1 != chunk_end) {
+				const auto later_match{ findMatch(inputs, position + 1, chunk_end,
+					source_relative_offset, target_relative_offset, true) };
+				// emitting a literal first costs about a byte, so the later match has to make up for that
+				if (later_match.benefit > match.benefit + 1) {
+					addLiteral();
+					++position;
+					next_match = later_match;
+					continue;
+				}
+			}
+
+			const auto& operation{ match.operation };
+			if (operation.action == Action::SOURCE_COPY) {
+				source_relative_offset = operation.offset + operation.length;
+			}
+			else if (operation.action == Action::TARGET_COPY) {
+				target_relative_offset = operation.offset + operation.length;
+			}
+			operations.push_back(operation);
+			position += operation.length;
+		}
+
+		return operations;
+	}
+
+	std::vector<char> Bps::create(const std::vector<char>& source, const std::vector<char>& target, Effort effort) {
+		const auto source_header_size{ getCopierHeaderSize(source.size()) };
+		const auto target_header_size{ getCopierHeaderSize(target.size()) };
+		const auto* const source_data{ source.data() + source_header_size };
+		const auto* const target_data{ target.data() + target_header_size };
+		const auto source_size{ source.size() - source_header_size };
+		const auto target_size{ target.size() - target_header_size };
+
+		if (source_size > UINT32_MAX || target_size > UINT32_MAX) {
+			throw BpsException("Cannot create BPS patches for files larger than 4GB");
+		}
+
+		const auto parameters{ getParameters(effort) };
+		const Index source_index{ source_data, source_size, parameters.key_size };
+		const Index target_index{ target_data, target_size, parameters.key_size };
+		const Inputs inputs{ source_data, source_size, target_data, target_size, source_index, target_index, parameters };
+
+		const auto chunk_count{ (target_size + CREATE_CHUNK_SIZE - 1) / CREATE_CHUNK_SIZE };
+		std::vector<std::vector<Operation>> chunk_operations(chunk_count);
+		Scheduler::forEach(chunk_count, [&](size_t chunk) {
+			chunk_operations[chunk] = matchChunk(inputs, chunk * CREATE_CHUNK_SIZE, 
+				std::min(target_size, (chunk + 1) * CREATE_CHUNK_SIZE));
+		});
+
+		std::vector<char> patch(std::begin(MAGIC), std::end(MAGIC));
+		writeNumber(patch, source_size);
+		writeNumber(patch, target_size);
+		writeNumber(patch, 0);
+
+		size_t output_offset{ 0 };
+		size_t source_relative_offset{ 0 };
+		size_t target_relative_offset{ 0 };
+		const auto writeOperation{ [&](const Operation& operation) {
+			writeNumber(patch, ((static_cast<uint64_t>(operation.length) - 1) << 2) | static_cast<uint64_t>(operation.action));
+
+			if (operation.action == Action::TARGET_READ) {
+				patch.insert(patch.end(), target_data + output_offset, target_data + output_offset + operation.length);
+			}
+			else if (operation.action != Action::SOURCE_READ) {
+				auto& relative_offset{ operation.action == Action::SOURCE_COPY ? source_relative_offset : target_relative_offset };
+				writeNumber(patch, encodeOffset(static_cast<int64_t>(operation.offset) - static_cast<int64_t>(relative_offset)));
+				relative_offset = operation.offset + operation.length;
+			}
+
+			output_offset += operation.length;
+		} };
+
+		// reads that continue across chunk borders are joined back together here
+		std::optional<Operation> pending{};
+		for (const auto& operations : chunk_operations) {
+			for (const auto& operation : operations) {
+				if (pending.has_value() && pending->action == operation.action
+					&& (operation.action == Action::SOURCE_READ || operation.action == Action::TARGET_READ)) {
+					pending->length += operation.length;
+					continue;
+				}
+				if (pending.has_value()) {
+					writeOperation(*pending);
+				}
+				pending = operation;
+			}
+		}
+		if (pending.has_value()) {
+			writeOperation(*pending);
+		}
+
+		writeCrc(patch, HashUtil::crc32(source_data, source_size));
+		writeCrc(patch, HashUtil::crc32(target_data, target_size));
+		writeCrc(patch, HashUtil::crc32(patch.data(), patch.size()));
+
+		return patch;
+	}
+
+	void Bps::createFile(const fs::path& source_path, const fs::path& target_path, const fs::path& patch_path, Effort effort) {
+		for (const auto& path : { source_path, target_path }) {
+			if (!fs::exists(path)) {
+				throw BpsException(fmt::format("Cannot create BPS patch, {} does not exist", path.string()));
+			}
+		}
+
+		const auto patch{ create(FileUtil::readAll(source_path), FileUtil::readAll(target_path), effort) };
+
+		std::ofstream out{ patch_path, std::ios::out | std::ios::binary };
+		out.write(patch.data(), patch.size());
+		out.close();
+		if (!out) {
+			throw BpsException(fmt::format("Failed to write BPS patch to {}", patch_path.string()));
+		}
+	}
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <filesystem>
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <optional>
+#include <bit>
+
+#include <fmt/format.h>
+
+#include "../callisto_exception.h"
+#include "../hash_util.h"
+#include "../file_util.h"
+#include "../globals.h"
+#include "../scheduler.h"
+
+namespace fs = std::filesystem;
+
+namespace callisto {
+	class BpsException : public CallistoException {
+	public:
+		using CallistoException::CallistoException;
+	};
+
+	// Applies and creates BPS patches in process, same format FLIPS reads and writes
+	class Bps {
+	public:
+		// How hard create() looks for matches, more effort means smaller patches but longer creation times
+		enum class Effort {
+			FAST,
+			BALANCED,
+			SMALL
+		};
+
+	protected:
+		static constexpr char MAGIC[]{ 'B', 'P', 'S', '1' };
+		static constexpr size_t FOOTER_SIZE{ 12 };
+		static constexpr size_t COPIER_HEADER_SIZE{ 512 };
+
+		enum class Action : uint8_t {
+			SOURCE_READ = 0,
+			TARGET_READ = 1,
+			SOURCE_COPY = 2,
+			TARGET_COPY = 3
+		};
+
+		class Reader {
+		protected:
+			const std::vector<char>& patch;
+			size_t offset{ 0 };
+			const size_t end;
+
+		public:
+			Reader(const std::vector<char>& patch, size_t end) : patch(patch), end(end) {}
+
+			uint8_t readByte();
+			uint64_t readNumber();
+			const char* readBytes(size_t count);
+			bool done() const { return offset == end; }
+			size_t position() const { return offset; }
+		};
+
+		static constexpr size_t CREATE_CHUNK_SIZE{ 0x10000 };
+
+		struct Parameters {
+			// number of bytes hashed to find match candidates, also the shortest copy we can find
+			size_t key_size;
+			size_t max_candidates;
+			// matches at least this long are taken right away instead of checking whether the next position does better
+			size_t nice_length;
+			bool lazy_matching;
+		};
+
+		struct Operation {
+			Action action;
+			size_t length;
+			// where a SOURCE_COPY or TARGET_COPY reads from, unused otherwise
+			size_t offset{ 0 };
+		};
+
+		struct Match {
+			Operation operation;
+			// bytes saved compared to storing the matched bytes as a TARGET_READ
+			int64_t benefit;
+		};
+
+		// All positions of a buffer grouped by the hash of the key_size bytes starting there,
+		// positions within a bucket are in ascending order
+		class Index {
+		protected:
+			const char* const data;
+			const size_t data_size;
+			const size_t key_size;
+			const size_t hash_bits;
+			std::vector<uint32_t> bucket_starts{};
+			std::vector<uint32_t> positions{};
+
+		public:
+			Index(const char* data, size_t data_size, size_t key_size);
+
+			uint32_t hashAt(const char* bytes) const;
+			std::pair<const uint32_t*, const uint32_t*> bucket(const char* bytes) const;
+		};
+
+		struct Inputs {
+			const char* source;
+			size_t source_size;
+			const char* target;
+			size_t target_size;
+			const Index& source_index;
+			const Index& target_index;
+			const Parameters& parameters;
+		};
+
+		static Match findMatch(const Inputs& inputs, size_t position, size_t limit,
+			size_t source_relative_offset, size_t target_relative_offset, bool literal_pending);
+		static std::vector<Operation> matchChunk(const Inputs& inputs, size_t chunk_start, size_t chunk_end);
+
+		static uint32_t readCrc(const std::vector<char>& data, size_t offset);
+		static void addChangedRange(std::vector<std::pair<size_t, size_t>>& ranges, size_t offset, size_t size);
+
+		static Parameters getParameters(Effort effort);
+		static size_t getCopierHeaderSize(size_t size);
+
+		static void writeNumber(std::vector<char>& patch, uint64_t number);
+		static void writeCrc(std::vector<char>& patch, uint32_t crc);
+		static size_t numberSize(uint64_t number);
+		static uint64_t encodeOffset(int64_t delta);
+
+	public:
+		struct Result {
+			std::vector<char> target;
+			// (offset, size) of every run of bytes that differs from the source, in ascending order
+			std::vector<std::pair<size_t, size_t>> changed_ranges;
+		};
+
+		// Throws BpsException if the patch is malformed or doesn't belong to the passed source, 
+		// if the source has a copier header the patch is applied behind it and the header is kept,
+		// the whole target is built in memory since SOURCE_COPY and TARGET_COPY can read from anywhere in 
+		// the source and the target written so far, ROMs are at most 16MB so streaming wouldn't save much
+		static Result apply(const std::vector<char>& patch, const std::vector<char>& source);
+
+		static Result applyFile(const fs::path& patch_path, const fs::path& source_path, const fs::path& target_path);
+
+		// Creates a patch that turns source into target, copier headers are left out of the patch like FLIPS does,
+		// the target is split into chunks that are matched in parallel, so the result does not depend on thread count
+		static std::vector<char> create(const std::vector<char>& source, const std::vector<char>& target, Effort effort);
+
+		static void createFile(const fs::path& source_path, const fs::path& target_path, const fs::path& patch_path, Effort effort);
+
+		// Parses "fast", "balanced" or "small", throws BpsException otherwise
+		static Effort parseEffort(std::string_view effort);
+	};
+}
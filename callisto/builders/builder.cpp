@@ -102,21 +102,17 @@ namespace callisto {
 		
 		report["inserted_levels"] = std::vector<int>();
 		if (config.levels.isSet()) {
-			for (const auto& entry : fs::directory_iterator(config.levels.getOrThrow())) {
-				if (entry.path().extension() != ".mwl") {
-					continue;
-				}
-				try {
-					const auto level_number{ Levels::getInternalLevelNumber(entry) };
-					report["inserted_levels"].push_back(level_number.value());
-				}
-				catch (const std::exception& e) {
+			const auto internal_level_numbers{ MwlIndex::getInternalLevelNumbers(config.levels.getOrThrow(), 
+				config.project_root.getOrThrow()) };
+			for (const auto& [path, level_number] : internal_level_numbers) {
+				if (!level_number.has_value()) {
 					throw InsertionException(fmt::format(
 						colors::EXCEPTION,
-						"Failed to determine source level number of level file '{}' with exception:\n\r{}",
-						entry.path().string(), e.what()
+						"Failed to determine source level number of level file '{}'",
+						path.string()
 					));
 				}
+				report["inserted_levels"].push_back(level_number.value());
 			}
 		}
 
@@ -172,7 +168,7 @@ namespace callisto {
 
 					while (true) {
 						try {
-							fs::copy_file(source, target, fs::copy_options::overwrite_existing);
+							FileUtil::copyIfDifferent(source, target);
 							break;
 						}
 						catch (const std::runtime_error& e) {
@@ -211,12 +207,12 @@ namespace callisto {
 		}
 	}
 	
-	void Builder::init(const Configuration& config) {
+	void Builder::init(const Configuration& config, bool keep_module_outputs) {
 		module_count = 0;
 
 		spdlog::info(fmt::format(colors::CALLISTO, "Initializing callisto directory"));
 		spdlog::info("");
-		ensureCacheStructure(config);
+		ensureCacheStructure(config, keep_module_outputs);
 		generateCallistoAsmFile(config);
 		fs::create_directories(config.temporary_folder.getOrThrow());
 		fs::create_directories(config.output_rom.getOrThrow().parent_path());
@@ -226,7 +222,7 @@ namespace callisto {
 		if (config.levels.isSet() && fs::exists(config.levels.getOrThrow())) {
 			spdlog::info(fmt::format(colors::CALLISTO, "Ensuring normalized level filenames"));
 			spdlog::info("");
-			Levels::normalizeMwls(config.levels.getOrThrow(), config.allow_user_input);
+			Levels::normalizeMwls(config.levels.getOrThrow(), config.project_root.getOrThrow(), config.allow_user_input);
 		}
 	}
 
@@ -341,17 +337,50 @@ namespace callisto {
 		}
 	}
 
-	void Builder::ensureCacheStructure(const Configuration& config) {
+	void Builder::ensureCacheStructure(const Configuration& config, bool keep_module_outputs) {
 		const auto project_root{ config.project_root.getOrThrow() };
 
-		fs::remove_all(PathUtil::getUserModuleDirectoryPath(project_root));
-		fs::remove_all(PathUtil::getModuleCleanupDirectoryPath(project_root));
+		if (keep_module_outputs) {
+			// outputs of modules that aren't reinserted are only overwritten if their content changed, so 
+			// we keep them around to preserve their timestamps and only get rid of ones no module produces anymore
+			removeStaleModuleOutputs(config);
+		}
+		else {
+			fs::remove_all(PathUtil::getUserModuleDirectoryPath(project_root));
+			fs::remove_all(PathUtil::getModuleCleanupDirectoryPath(project_root));
+		}
 
 		fs::create_directories(PathUtil::getModuleCleanupDirectoryPath(project_root));
 		fs::create_directories(PathUtil::getModuleOldSymbolsDirectoryPath(project_root));
 		fs::create_directories(PathUtil::getUserModuleDirectoryPath(project_root));
 	}
 
+	void Builder::removeStaleModuleOutputs(const Configuration& config) {
+		const auto module_directory{ PathUtil::getUserModuleDirectoryPath(config.project_root.getOrThrow()) };
+		if (!fs::exists(module_directory)) {
+			return;
+		}
+
+		std::unordered_set<fs::path> current_outputs{};
+		for (const auto& [_, module_config] : config.module_configurations) {
+			for (const auto& output_path : module_config.real_output_paths.getOrThrow()) {
+				current_outputs.insert(fs::weakly_canonical(output_path));
+			}
+		}
+
+		std::vector<fs::path> stale_outputs{};
+		for (const auto& entry : fs::recursive_directory_iterator(module_directory)) {
+			if (entry.is_regular_file() && !current_outputs.contains(fs::weakly_canonical(entry.path()))) {
+				stale_outputs.push_back(entry.path());
+			}
+		}
+
+		for (const auto& stale_output : stale_outputs) {
+			spdlog::debug("Removing stale module output '{}'", stale_output.string());
+			fs::remove(stale_output);
+		}
+	}
+
 	void Builder::generateCallistoAsmFile(const Configuration& config) {
 		const auto module_folder{ PathUtil::getUserModuleDirectoryPath(config.project_root.getOrThrow()) };
 
@@ -464,7 +493,7 @@ namespace callisto {
 			DEFINE_PREFIX, VERSION_DEFINE_NAME
 		) };
 
-		writeIfDifferent(info_string, PathUtil::getCallistoAsmFilePath(config.project_root.getOrThrow()));
+		FileUtil::writeIfDifferent(info_string, PathUtil::getCallistoAsmFilePath(config.project_root.getOrThrow()));
 	}
 
 	void Builder::checkCleanRom(const fs::path& clean_rom_path) {
@@ -536,21 +565,6 @@ namespace callisto {
 		}
 	}
 
-	void Builder::writeIfDifferent(const std::string& str, const fs::path& out_file) {
-		std::ifstream in_file{ out_file };
-
-		std::string content((std::istreambuf_iterator<char>(in_file)),
-			(std::istreambuf_iterator<char>()));
-
-		in_file.close();
-
-		if (content != str) {
-			std::ofstream out{ out_file };
-			out << str;
-			out.close();
-		}
-	}
-
 	void Builder::removeBuildReport(const fs::path& project_root) {
 		const auto path{ PathUtil::getBuildReportPath(project_root) };
 		try {
@@ -29,6 +29,7 @@
 #include "../descriptor.h"
 
 #include "../time_util.h"
+#include "../file_util.h"
 #include "../prompt_util.h"
 
 using json = nlohmann::json;
@@ -76,8 +77,9 @@ namespace callisto {
 		static void cacheModules(const fs::path& project_root);
 		static void moveTempToOutput(const Configuration& config);
 
-		void init(const Configuration& config);
-		static void ensureCacheStructure(const Configuration& config);
+		void init(const Configuration& config, bool keep_module_outputs = false);
+		static void ensureCacheStructure(const Configuration& config, bool keep_module_outputs);
+		static void removeStaleModuleOutputs(const Configuration& config);
 		static void generateCallistoAsmFile(const Configuration& config);
 
 		static void tryConvenienceSetup(const Configuration& config);
@@ -91,8 +93,6 @@ namespace callisto {
 
 		static void checkCleanRom(const fs::path& clean_rom_path);
 
-		static void writeIfDifferent(const std::string& str, const fs::path& out_file);
-
 		static void removeBuildReport(const fs::path& project_root);
 	};
 }
@@ -22,7 +22,7 @@ namespace callisto {
 		spdlog::info(fmt::format(colors::ACTION_START, "Update started"));
 		spdlog::info("");
 
-		init(config);
+		init(config, true);
 
 		spdlog::info(fmt::format(colors::CALLISTO, "Checking whether ROM from previous build exists"));
 		if (!fs::exists(config.output_rom.getOrThrow())) {
@@ -37,13 +37,25 @@ namespace callisto {
 		spdlog::info("");
 
 		spdlog::info(fmt::format(colors::CALLISTO, "Checking whether build order has changed"));
-		checkBuildOrderChange(config);
-		spdlog::info(fmt::format(colors::PARTIAL_SUCCESS, "Build order has not changed"));
+		const auto build_order_changes{ checkBuildOrderChange(config) };
+		const auto& appended_descriptors{ build_order_changes.appended };
+		if (appended_descriptors.empty() && build_order_changes.removed_patches.empty()) {
+			spdlog::info(fmt::format(colors::PARTIAL_SUCCESS, "Build order has not changed"));
+		}
+		if (!build_order_changes.removed_patches.empty()) {
+			spdlog::info(fmt::format(colors::PARTIAL_SUCCESS, "{} patch{} removed from the build order, will attempt to undo {} changes",
+				build_order_changes.removed_patches.size(), build_order_changes.removed_patches.size() == 1 ? " was" : "es were",
+				build_order_changes.removed_patches.size() == 1 ? "its" : "their"));
+		}
+		if (!appended_descriptors.empty()) {
+			spdlog::info(fmt::format(colors::PARTIAL_SUCCESS, "{} new entr{} appended to the end of the build order, "
+				"will be applied to the existing ROM", appended_descriptors.size(), appended_descriptors.size() == 1 ? "y was" : "ies were"));
+		}
 		spdlog::info("");
 
 		if (config.levels.isSet()) {
 			spdlog::info(fmt::format(colors::CALLISTO, "Checking whether level files have been removed since last build"));
-			checkProblematicLevelChanges(config.levels.getOrThrow(), report["inserted_levels"]);
+			checkProblematicLevelChanges(config.levels.getOrThrow(), config.project_root.getOrThrow(), report["inserted_levels"]);
 			spdlog::info(fmt::format(colors::PARTIAL_SUCCESS, "No level files have been removed"));
 			spdlog::info("");
 		}
@@ -60,9 +72,52 @@ namespace callisto {
 
 		bool any_work_done{ false };
 		bool anything_ran{ false };
+
+		// undo removed patches latest first, so each one finds the ROM the way it left it
+		for (const auto& removed_patch : build_order_changes.removed_patches | std::views::reverse) {
+			const auto removed_entry{ std::find_if(json_dependencies.begin(), json_dependencies.end(), [&](const json& entry) {
+				return Descriptor(entry["descriptor"]) == removed_patch;
+			}) };
+
+			if (removed_entry == json_dependencies.end()) {
+				throw MustRebuildException(fmt::format(
+					colors::NOTIFICATION,
+					"No record of removed {} found, must rebuild",
+					removed_patch.toString(config.project_root.getOrThrow())
+				));
+			}
+
+			if (!fs::exists(temporary_rom_path)) {
+				fs::copy(config.output_rom.getOrThrow(), temporary_rom_path, fs::copy_options::overwrite_existing);
+			}
+
+			const auto entry_index{ static_cast<size_t>(std::distance(json_dependencies.begin(), removed_entry)) };
+			if (!tryRollBackPatch(json_dependencies, entry_index, temporary_rom_path, config.project_root.getOrThrow())) {
+				throw MustRebuildException(fmt::format(
+					colors::NOTIFICATION,
+					"Changes made by removed {} cannot be undone safely, must rebuild",
+					removed_patch.toString(config.project_root.getOrThrow())
+				));
+			}
+
+			spdlog::info(fmt::format(colors::PARTIAL_SUCCESS, "Undid changes made by removed {}", 
+				removed_patch.toString(config.project_root.getOrThrow())));
+			json_dependencies.erase(entry_index);
+			fs::remove(PathUtil::getPatchWriteSetPath(config.project_root.getOrThrow(),
+				fs::relative(removed_patch.name.value(), config.project_root.getOrThrow())));
+
+			anything_ran = true;
+			any_work_done = true;
+		}
+
+		if (!build_order_changes.removed_patches.empty()) {
+			spdlog::info("");
+		}
+
 		std::optional<Insertable::NoDependencyReportFound> failed_dependency_report;
 		size_t i{ 0 };
 		for (auto& entry : json_dependencies) {
+			const auto entry_index{ i };
 			checkRebuildResourceDependencies(json_dependencies, config.project_root.getOrThrow(), i++);
 			const auto descriptor{ Descriptor(entry["descriptor"]) };
 			spdlog::info(fmt::format(colors::CALLISTO, "--- {} ---", descriptor.toString(config.project_root.getOrThrow())));
@@ -151,70 +206,56 @@ namespace callisto {
 				if (!fs::exists(temporary_rom_path)) {
 					fs::copy(config.output_rom.getOrThrow(), temporary_rom_path, fs::copy_options::overwrite_existing);
 				}
+				std::optional<Module::Placement> previous_placement{};
 				if (descriptor.symbol == Symbol::MODULE) {
-					cleanModule(
+					previous_placement = cleanModule(
 						descriptor.name.value(),
 						temporary_rom_path,
 						config.project_root.getOrThrow()
 					);
 				}
 
+				// if we can put back what the patch overwrote last time, it doesn't matter whether its hijacks change
+				const auto rolled_back{ descriptor.symbol == Symbol::PATCH 
+					&& tryRollBackPatch(json_dependencies, entry_index, temporary_rom_path, config.project_root.getOrThrow()) };
+
 				auto insertable{ descriptorToInsertable(descriptor, config) };
 
-				insertable->init();
-				if (!failed_dependency_report.has_value()) {
-					std::unordered_set<ResourceDependency> resource_dependencies;
+				if (previous_placement.has_value()) {
+					static_pointer_cast<Module>(insertable)->setPreviousPlacement(previous_placement.value());
+				}
 
-					const auto curr_path{ fs::current_path() };
-					try {
-						resource_dependencies = insertable->insertWithDependencies();
-					}
-					catch (const Insertable::NoDependencyReportFound& e) {
-						failed_dependency_report = e;
-					}
-					catch (...) {
-						fs::current_path(curr_path);
-						try {
-							fs::remove_all(config.temporary_folder.getOrThrow());
-						}
-						catch (const std::runtime_error& e) {
-							spdlog::warn(fmt::format(colors::WARNING, "Failed to remove temporary folder '{}'",
-								config.temporary_folder.getOrThrow().string()));
-						}
-						throw;
-					}
-					spdlog::info("");
+				if (descriptor.symbol == Symbol::PATCH && !rolled_back) {
+					static_pointer_cast<Patch>(insertable)->setPreviousWriteSet(WriteSet::read(PathUtil::getPatchWriteSetPath(
+						config.project_root.getOrThrow(), fs::relative(descriptor.name.value(), config.project_root.getOrThrow()))));
+				}
 
-					if (!failed_dependency_report.has_value()) {
-						const auto config_dependencies{ insertable->getConfigurationDependencies() };
-						entry["resource_dependencies"] = std::vector<json>();
-						entry["configuration_dependencies"] = std::vector<json>();
+				// only importing the changed levels is fine as long as nothing but the level files themselves changed, 
+				// anything else (e.g. the Lunar Magic version or level import flags) could affect every level
+				if (descriptor.symbol == Symbol::LEVELS && entry.contains("mwl_fingerprints") && !config_result.has_value()
+					&& onlyLevelFilesChanged(entry["resource_dependencies"], config.levels.getOrThrow())) {
+					static_pointer_cast<Levels>(insertable)->setPreviousFingerprints(
+						entry["mwl_fingerprints"].get<Levels::Fingerprints>());
+				}
+				else if (descriptor.symbol == Symbol::GRAPHICS && entry.contains("graphics_fingerprints")) {
+					static_pointer_cast<Graphics>(insertable)->setPreviousFingerprints(
+						entry["graphics_fingerprints"].get<GraphicsUtil::Fingerprints>());
+				}
+				else if (descriptor.symbol == Symbol::EX_GRAPHICS && entry.contains("graphics_fingerprints")) {
+					static_pointer_cast<ExGraphics>(insertable)->setPreviousFingerprints(
+						entry["graphics_fingerprints"].get<GraphicsUtil::Fingerprints>());
+				}
 
-						for (const auto& config_dep : config_dependencies) {
-							entry["configuration_dependencies"].push_back(config_dep.toJson());
-						}
-						for (const auto& resource_dep : resource_dependencies) {
-							entry["resource_dependencies"].push_back(resource_dep.toJson());
-						}
-					}
+				insertEntry(insertable, entry, config, failed_dependency_report);
+
+				if (descriptor.symbol == Symbol::LEVELS) {
+					entry["mwl_fingerprints"] = static_pointer_cast<Levels>(insertable)->getFingerprints();
 				}
-				else {
-					const auto curr_path{ fs::current_path() };
-					try {
-						insertable->insert();
-						spdlog::info("");
-					}
-					catch (...) {
-						fs::current_path(curr_path);
-						try {
-							fs::remove_all(config.temporary_folder.getOrThrow());
-						}
-						catch (const std::runtime_error& e) {
-							spdlog::warn(fmt::format(colors::WARNING, "Failed to remove temporary folder '{}'",
-								config.temporary_folder.getOrThrow().string()));
-						}
-						throw;
-					}
+				else if (descriptor.symbol == Symbol::GRAPHICS) {
+					entry["graphics_fingerprints"] = static_pointer_cast<Graphics>(insertable)->getFingerprints();
+				}
+				else if (descriptor.symbol == Symbol::EX_GRAPHICS) {
+					entry["graphics_fingerprints"] = static_pointer_cast<ExGraphics>(insertable)->getFingerprints();
 				}
 
 				if (descriptor.symbol == Symbol::PATCH) {
@@ -222,7 +263,7 @@ namespace callisto {
 					const auto patch{ static_pointer_cast<Patch>(insertable) };
 					const auto& new_hijacks{ patch->getHijacks() };
 
-					if (hijacksGoneBad(old_hijacks, new_hijacks)) {
+					if (!rolled_back && hijacksGoneBad(old_hijacks, new_hijacks)) {
 						throw MustRebuildException(fmt::format(
 							colors::NOTIFICATION,
 							"Hijacks of patch {} have changed, must rebuild", patch->project_relative_path.string()));
@@ -233,16 +274,7 @@ namespace callisto {
 				}
 				
 				anything_ran = true;
-				if (!any_work_done) {
-					if (descriptor.symbol == Symbol::EXTERNAL_TOOL) {
-						if (config.generic_tool_configurations.at(descriptor.name.value()).pass_rom.getOrDefault(true)) {
-							any_work_done = true;
-						}
-					}
-					else {
-						any_work_done = true;
-					}
-				}
+				any_work_done = any_work_done || modifiesRom(descriptor, config);
 			}
 			else {
 				if (descriptor.symbol == Symbol::MODULE) {
@@ -260,6 +292,43 @@ namespace callisto {
 			}
 		}
 
+		for (const auto& descriptor : appended_descriptors) {
+			spdlog::info(fmt::format(colors::CALLISTO, "--- {} ---", descriptor.toString(config.project_root.getOrThrow())));
+			spdlog::info(fmt::format(colors::NOTIFICATION, "{} was newly added to the build order and must be applied",
+				descriptor.toString(config.project_root.getOrThrow())));
+
+			if (!fs::exists(temporary_rom_path)) {
+				fs::copy(config.output_rom.getOrThrow(), temporary_rom_path, fs::copy_options::overwrite_existing);
+			}
+
+			auto entry{ json({
+				{"descriptor", descriptor.toJson()},
+				{"resource_dependencies", std::vector<json>()},
+				{"configuration_dependencies", std::vector<json>()}
+			}) };
+
+			const auto insertable{ descriptorToInsertable(descriptor, config) };
+			insertEntry(insertable, entry, config, failed_dependency_report);
+
+			if (descriptor.symbol == Symbol::PATCH) {
+				entry["hijacks"] = static_pointer_cast<Patch>(insertable)->getHijacks();
+			}
+			else if (descriptor.symbol == Symbol::LEVELS) {
+				entry["mwl_fingerprints"] = static_pointer_cast<Levels>(insertable)->getFingerprints();
+			}
+			else if (descriptor.symbol == Symbol::GRAPHICS) {
+				entry["graphics_fingerprints"] = static_pointer_cast<Graphics>(insertable)->getFingerprints();
+			}
+			else if (descriptor.symbol == Symbol::EX_GRAPHICS) {
+				entry["graphics_fingerprints"] = static_pointer_cast<ExGraphics>(insertable)->getFingerprints();
+			}
+
+			json_dependencies.push_back(entry);
+
+			anything_ran = true;
+			any_work_done = any_work_done || modifiesRom(descriptor, config);
+		}
+
 		if (any_work_done || anything_ran) {
 			if (!failed_dependency_report.has_value()) {
 				writeBuildReport(config.project_root.getOrThrow(), createBuildReport(config, report["dependencies"]));
@@ -320,21 +389,213 @@ namespace callisto {
 		}
 	}
 
-	void QuickBuilder::checkBuildOrderChange(const Configuration& config) const {
-		if (config.build_order.size() != report["build_order"].size()) {
-			throw MustRebuildException(fmt::format(colors::NOTIFICATION, "Build order has changed, must rebuild"));
+	QuickBuilder::BuildOrderChanges QuickBuilder::checkBuildOrderChange(const Configuration& config) const {
+		const auto& old_build_order{ report["build_order"] };
+		const auto& new_build_order{ config.build_order };
+
+		// the new build order must be the old one with some patches dropped and possibly 
+		// some entries added at the end, anything else means things got reordered
+		BuildOrderChanges changes{};
+		size_t matched{ 0 };
+		for (size_t old_index{ 0 }; old_index != old_build_order.size(); ++old_index) {
+			const auto old_descriptor{ Descriptor(old_build_order.at(old_index)) };
+			if (matched != new_build_order.size() && old_descriptor == new_build_order.at(matched)) {
+				++matched;
+			}
+			else if (old_descriptor.symbol == Symbol::PATCH 
+				&& std::find(new_build_order.begin(), new_build_order.end(), old_descriptor) == new_build_order.end()) {
+				changes.removed_patches.push_back(old_descriptor);
+			}
+			else {
+				throw MustRebuildException(fmt::format(
+					colors::NOTIFICATION,
+					"Build order has changed at entry {}, must rebuild",
+					old_index + 1
+				));
+			}
 		}
-		
-		size_t i{ 0 };
-		for (const auto& new_descriptor : config.build_order) {
-			const auto old_descriptor{ Descriptor(report["build_order"].at(i++)) };
-			if (old_descriptor != new_descriptor) {
-				throw MustRebuildException(fmt::format(colors::NOTIFICATION, "Build order has changed, must rebuild"));
+
+		changes.appended = std::vector<Descriptor>(new_build_order.begin() + matched, new_build_order.end());
+
+		for (const auto& descriptor : changes.appended) {
+			if (descriptor.symbol == Symbol::INITIAL_PATCH) {
+				throw MustRebuildException(fmt::format(colors::NOTIFICATION, "Initial patch was added to the build order, must rebuild"));
+			}
+
+			// entries in the build report are unique per descriptor, so entries that show up more than 
+			// once can't be tracked incrementally
+			if (std::count(new_build_order.begin(), new_build_order.end(), descriptor) != 1) {
+				throw MustRebuildException(fmt::format(
+					colors::NOTIFICATION,
+					"{} was added to the build order more than once, must rebuild",
+					descriptor.toString(config.project_root.getOrThrow())
+				));
 			}
 		}
+
+		return changes;
 	}
 
-	void QuickBuilder::checkProblematicLevelChanges(const fs::path& levels_path, const std::unordered_set<int>& old_level_numbers) {
+	bool QuickBuilder::tryRollBackPatch(const json& dependencies, size_t entry_index, const fs::path& temporary_rom_path, 
+		const fs::path& project_root) const {
+		const auto descriptor{ Descriptor(dependencies.at(entry_index)["descriptor"]) };
+		const auto write_set{ WriteSet::read(PathUtil::getPatchWriteSetPath(project_root, 
+			fs::relative(descriptor.name.value(), project_root))) };
+
+		if (!write_set.has_value()) {
+			spdlog::debug("No record of bytes written by {}", descriptor.toString(project_root));
+			return false;
+		}
+
+		// if any later patch hijacked the same bytes, undoing ours would break theirs
+		for (size_t i{ entry_index + 1 }; i < dependencies.size(); ++i) {
+			const auto& later_entry{ dependencies.at(i) };
+			if (later_entry.contains("hijacks") 
+				&& write_set.value().overlaps(later_entry["hijacks"].get<std::vector<std::pair<size_t, size_t>>>())) {
+				spdlog::debug("Bytes written by {} were later hijacked by {}", descriptor.toString(project_root),
+					Descriptor(later_entry["descriptor"]).toString(project_root));
+				return false;
+			}
+		}
+
+		auto rom_bytes{ FileUtil::readAll(temporary_rom_path) };
+		const auto header_size{ rom_bytes.size() & 0x7FFF };
+		const auto unheadered_rom_size{ rom_bytes.size() - header_size };
+
+		// anyone else writing over our bytes since means we can't know what should be there instead
+		if (!write_set.value().isIntact(rom_bytes.data() + header_size, unheadered_rom_size)) {
+			spdlog::debug("Bytes written by {} have since been overwritten", descriptor.toString(project_root));
+			return false;
+		}
+
+		write_set.value().rollBack(rom_bytes.data() + header_size, unheadered_rom_size);
+
+		// the freespace we just freed must not be used by anything inserted after us, since that won't be reinserted
+		if (write_set.value().hasFreespace()) {
+			const auto referencing_entry{ findFreespaceReference(write_set.value(), dependencies, entry_index, 
+				rom_bytes.data() + header_size, unheadered_rom_size, project_root) };
+			if (referencing_entry.has_value()) {
+				spdlog::debug("Freespace written by {} is used by {}", descriptor.toString(project_root), referencing_entry.value());
+				return false;
+			}
+		}
+
+		std::ofstream out_rom{ temporary_rom_path, std::ios::out | std::ios::binary };
+		out_rom.write(rom_bytes.data(), rom_bytes.size());
+		out_rom.close();
+
+		spdlog::debug("Rolled back bytes written by {}", descriptor.toString(project_root));
+		return true;
+	}
+
+	std::optional<std::string> QuickBuilder::findFreespaceReference(const WriteSet& write_set, const json& dependencies, 
+		size_t entry_index, const char* rolled_back_rom, size_t rom_size, const fs::path& project_root) {
+		for (size_t i{ entry_index + 1 }; i < dependencies.size(); ++i) {
+			const auto later_descriptor{ Descriptor(dependencies.at(i)["descriptor"]) };
+
+			if (later_descriptor.symbol == Symbol::PATCH) {
+				const auto later_write_set{ WriteSet::read(PathUtil::getPatchWriteSetPath(project_root,
+					fs::relative(later_descriptor.name.value(), project_root))) };
+				if (!later_write_set.has_value() || write_set.overlaps(later_write_set.value())) {
+					return later_descriptor.toString(project_root);
+				}
+
+				for (const auto& range : later_write_set.value().ranges) {
+					if (write_set.isReferencedFrom(range.post_image.data(), range.post_image.size(), false)) {
+						return later_descriptor.toString(project_root);
+					}
+				}
+			}
+			else if (later_descriptor.symbol == Symbol::MODULE) {
+				const auto relative{ fs::relative(later_descriptor.name.value(), project_root) };
+				const auto placement{ Module::readPlacementFile(PathUtil::getModuleCleanupCacheDirectoryPath(project_root) /
+					((relative.parent_path() / relative.stem()).string() + ".place")) };
+				if (!placement.has_value()) {
+					return later_descriptor.toString(project_root);
+				}
+
+				for (const auto& [pc_address, size] : placement.value().areas) {
+					if (pc_address >= rom_size || write_set.overlaps({ { pc_address, size } })
+						|| write_set.isReferencedFrom(rolled_back_rom + pc_address, std::min(size, rom_size - pc_address), false)) {
+						return later_descriptor.toString(project_root);
+					}
+				}
+			}
+		}
+
+		// hooks placed by anything else, like tools, show up as long jumps in the original ROM area,
+		// our own hooks are already rolled back at this point
+		if (write_set.isReferencedFrom(rolled_back_rom, std::min<size_t>(rom_size, 0x80000), true)) {
+			return "a hook in the original ROM area";
+		}
+
+		return {};
+	}
+
+	bool QuickBuilder::modifiesRom(const Descriptor& descriptor, const Configuration& config) {
+		if (descriptor.symbol == Symbol::EXTERNAL_TOOL) {
+			return config.generic_tool_configurations.at(descriptor.name.value()).pass_rom.getOrDefault(true);
+		}
+		return true;
+	}
+
+	void QuickBuilder::insertEntry(std::shared_ptr<Insertable> insertable, json& entry, const Configuration& config,
+		std::optional<Insertable::NoDependencyReportFound>& failed_dependency_report) const {
+		insertable->init();
+		if (!failed_dependency_report.has_value()) {
+			std::unordered_set<ResourceDependency> resource_dependencies;
+
+			try {
+				resource_dependencies = insertable->insertWithDependencies();
+			}
+			catch (const Insertable::NoDependencyReportFound& e) {
+				failed_dependency_report = e;
+			}
+			catch (...) {
+				try {
+					fs::remove_all(config.temporary_folder.getOrThrow());
+				}
+				catch (const std::runtime_error& e) {
+					spdlog::warn(fmt::format(colors::WARNING, "Failed to remove temporary folder '{}'",
+						config.temporary_folder.getOrThrow().string()));
+				}
+				throw;
+			}
+			spdlog::info("");
+
+			if (!failed_dependency_report.has_value()) {
+				const auto config_dependencies{ insertable->getConfigurationDependencies() };
+				entry["resource_dependencies"] = std::vector<json>();
+				entry["configuration_dependencies"] = std::vector<json>();
+
+				for (const auto& config_dep : config_dependencies) {
+					entry["configuration_dependencies"].push_back(config_dep.toJson());
+				}
+				for (const auto& resource_dep : resource_dependencies) {
+					entry["resource_dependencies"].push_back(resource_dep.toJson());
+				}
+			}
+		}
+		else {
+			try {
+				insertable->insert();
+				spdlog::info("");
+			}
+			catch (...) {
+				try {
+					fs::remove_all(config.temporary_folder.getOrThrow());
+				}
+				catch (const std::runtime_error& e) {
+					spdlog::warn(fmt::format(colors::WARNING, "Failed to remove temporary folder '{}'",
+						config.temporary_folder.getOrThrow().string()));
+				}
+				throw;
+			}
+		}
+	}
+
+	void QuickBuilder::checkProblematicLevelChanges(const fs::path& levels_path, const fs::path& project_root, 
+		const std::unordered_set<int>& old_level_numbers) {
 		std::unordered_set<int> new_level_numbers{};
 		
 		if (!fs::exists(levels_path)) {
@@ -346,19 +607,15 @@ namespace callisto {
 			));
 		}
 
-		for (const auto& entry : fs::directory_iterator(levels_path)) {
-			if (entry.path().extension() == ".mwl") {
-				try {
-					new_level_numbers.insert(Levels::getInternalLevelNumber(entry).value());
-				}
-				catch (const std::exception& e) {
-					throw InsertionException(fmt::format(
-						colors::EXCEPTION,
-						"Failed to determine source level number of level file '{}' with exception:\n\r{}",
-						entry.path().string(), e.what()
-					));
-				}
+		for (const auto& [path, level_number] : MwlIndex::getInternalLevelNumbers(levels_path, project_root)) {
+			if (!level_number.has_value()) {
+				throw InsertionException(fmt::format(
+					colors::EXCEPTION,
+					"Failed to determine source level number of level file '{}'",
+					path.string()
+				));
 			}
+			new_level_numbers.insert(level_number.value());
 		}
 
 		const auto old_missing_from_new{
@@ -438,27 +695,45 @@ namespace callisto {
 		return {};
 	}
 
+	bool QuickBuilder::hasChanged(const ResourceDependency& resource_dependency) {
+		std::optional<uint64_t> new_timestamp{
+			fs::exists(resource_dependency.dependent_path) ?
+			std::make_optional(fs::last_write_time(resource_dependency.dependent_path).time_since_epoch().count()) :
+			std::nullopt };
+		return new_timestamp != resource_dependency.last_write_time;
+	}
+
 	std::optional<ResourceDependency> QuickBuilder::checkReinsertResourceDependencies(const json& resource_dependencies) const {
 		for (const auto& entry : resource_dependencies) {
 			const auto resource_dependency{ ResourceDependency(entry) };
-			if (resource_dependency.policy == Policy::REINSERT) {
-				std::optional<uint64_t> new_timestamp{
-					fs::exists(resource_dependency.dependent_path) ?
-					std::make_optional(fs::last_write_time(resource_dependency.dependent_path).time_since_epoch().count()) :
-					std::nullopt };
-				if (new_timestamp != resource_dependency.last_write_time) {
-					return resource_dependency;
-				}
+			if (resource_dependency.policy == Policy::REINSERT && hasChanged(resource_dependency)) {
+				return resource_dependency;
 			}
 		}
 		return {};
 	}
 
-	void QuickBuilder::cleanModule(const fs::path& module_source_path, const fs::path& temporary_rom_path, const fs::path& project_root) {
+	bool QuickBuilder::onlyLevelFilesChanged(const json& resource_dependencies, const fs::path& levels_folder) {
+		for (const auto& entry : resource_dependencies) {
+			const auto resource_dependency{ ResourceDependency(entry) };
+			// the folder itself changes whenever a level file is added
+			const auto is_level_file{ resource_dependency.dependent_path.extension() == ".mwl"
+				|| resource_dependency.dependent_path.lexically_normal() == levels_folder.lexically_normal() };
+			if (!is_level_file && hasChanged(resource_dependency)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	std::optional<Module::Placement> QuickBuilder::cleanModule(const fs::path& module_source_path, 
+		const fs::path& temporary_rom_path, const fs::path& project_root) {
 		const auto relative{ fs::relative(module_source_path, project_root) };
 		const auto cleanup_file{ PathUtil::getModuleCleanupCacheDirectoryPath(project_root) /
 			((relative.parent_path() / relative.stem()).string() + ".addr")
 		};
+		const auto placement{ Module::readPlacementFile(PathUtil::getModuleCleanupCacheDirectoryPath(project_root) /
+			((relative.parent_path() / relative.stem()).string() + ".place")) };
 
 		if (!fs::exists(cleanup_file)) {
 			throw MustRebuildException(fmt::format(
@@ -523,9 +798,16 @@ namespace callisto {
 				"Successfully cleaned module {}",
 				module_source_path.string()
 			);
+
+			if (placement.has_value()) {
+				Module::releaseReservations(placement.value(), rom_bytes.data() + header_size, unheadered_rom_size);
+			}
+
 			std::ofstream out_rom{ temporary_rom_path, std::ios::out | std::ios::binary };
 			out_rom.write(rom_bytes.data(), rom_bytes.size());
 			out_rom.close();
+
+			return placement;
 		}
 		else {
 			throw MustRebuildException(fmt::format(
@@ -552,7 +834,7 @@ namespace callisto {
 
 			const auto target{ PathUtil::getUserModuleDirectoryPath(project_root) / relative };
 			fs::create_directories(target.parent_path());
-			fs::copy_file(source, target, fs::copy_options::overwrite_existing);
+			FileUtil::copyIfDifferent(source, target);
 
 			const auto rel_source{ fs::relative(module_source_path, project_root) };
 			const auto cleanup_file{ PathUtil::getModuleCleanupCacheDirectoryPath(project_root) /
@@ -568,10 +850,18 @@ namespace callisto {
 
 			module_cleanup_file.close();
 
-			const fs::path cleanup_target{ (PathUtil::getModuleCleanupDirectoryPath(project_root) / 
-				rel_source.parent_path() / rel_source.stem()).string() + ".addr"};
-			fs::create_directories(cleanup_target.parent_path());
-			fs::copy_file(cleanup_file, cleanup_target, fs::copy_options::overwrite_existing);
+			for (const auto& extension : { ".addr", ".place" }) {
+				const fs::path cleanup_source{ (PathUtil::getModuleCleanupCacheDirectoryPath(project_root) /
+					rel_source.parent_path() / rel_source.stem()).string() + extension };
+				if (!fs::exists(cleanup_source)) {
+					continue;
+				}
+
+				const fs::path cleanup_target{ (PathUtil::getModuleCleanupDirectoryPath(project_root) / 
+					rel_source.parent_path() / rel_source.stem()).string() + extension };
+				fs::create_directories(cleanup_target.parent_path());
+				FileUtil::copyIfDifferent(cleanup_source, cleanup_target);
+			}
 		}
 	}
 
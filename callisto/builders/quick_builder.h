@@ -1,5 +1,7 @@
 #pragma once
 
+#include <ranges>
+
 #include <spdlog/spdlog.h>
 
 #include "builder.h"
@@ -7,6 +9,7 @@
 #include "../insertables/initial_patch.h"
 #include "must_rebuild_exception.h"
 #include "../insertables/module.h"
+#include "../insertables/write_set.h"
 #include "../saver/saver.h"
 
 namespace callisto {
@@ -19,20 +22,40 @@ namespace callisto {
 	protected:
 		static constexpr auto MAX_ROM_SIZE = 16 * 1024 * 1024;
 
+		struct BuildOrderChanges {
+			std::vector<Descriptor> removed_patches{};
+			std::vector<Descriptor> appended{};
+		};
+
 		json report;
 
 		void checkBuildReportFormat() const;
-		void checkBuildOrderChange(const Configuration& config) const;
-		static void checkProblematicLevelChanges(const fs::path& levels_path, const std::unordered_set<int>& old_level_numbers);
+		BuildOrderChanges checkBuildOrderChange(const Configuration& config) const;
+		static void checkProblematicLevelChanges(const fs::path& levels_path, const fs::path& project_root, 
+			const std::unordered_set<int>& old_level_numbers);
 		void checkRebuildConfigDependencies(const json& dependencies, const Configuration& config) const;
 		void checkRebuildResourceDependencies(const json& dependencies, const fs::path& project_root, size_t starting_index = 0) const;
 		std::optional<ConfigurationDependency> checkReinsertConfigDependencies(const json& config_dependencies, const Configuration& config) const;
 		std::optional<ResourceDependency> checkReinsertResourceDependencies(const json& resource_dependencies) const;
+		static bool hasChanged(const ResourceDependency& resource_dependency);
+		static bool onlyLevelFilesChanged(const json& resource_dependencies, const fs::path& levels_folder);
 
-		static void cleanModule(const fs::path& module_source_path, const fs::path& temporary_rom_path, const fs::path& project_root);
+		static std::optional<Module::Placement> cleanModule(const fs::path& module_source_path, const fs::path& temporary_rom_path, 
+			const fs::path& project_root);
 		void copyOldModuleOutput(const std::vector<fs::path>& module_output_paths, const fs::path& module_source_path, 
 			const fs::path& project_root);
 
+		void insertEntry(std::shared_ptr<Insertable> insertable, json& entry, const Configuration& config,
+			std::optional<Insertable::NoDependencyReportFound>& failed_dependency_report) const;
+		static bool modifiesRom(const Descriptor& descriptor, const Configuration& config);
+
+		bool tryRollBackPatch(const json& dependencies, size_t entry_index, const fs::path& temporary_rom_path, 
+			const fs::path& project_root) const;
+
+		// Returns what still points into or overlaps the freespace write_set wrote, looking at everything after entry_index
+		static std::optional<std::string> findFreespaceReference(const WriteSet& write_set, const json& dependencies, 
+			size_t entry_index, const char* rolled_back_rom, size_t rom_size, const fs::path& project_root);
+
 		static bool hijacksGoneBad(const std::vector<std::pair<size_t, size_t>>& old_hijacks, 
 			const std::vector<std::pair<size_t, size_t>>& new_hijacks);
 
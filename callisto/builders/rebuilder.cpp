@@ -16,6 +16,9 @@ namespace callisto {
 
 		DependencyVector dependencies{};
 		PatchHijacksVector patch_hijacks{};
+		std::optional<Levels::Fingerprints> level_fingerprints{};
+		std::optional<GraphicsUtil::Fingerprints> graphics_fingerprints{};
+		std::optional<GraphicsUtil::Fingerprints> exgraphics_fingerprints{};
 
 		const auto temp_rom_path{ PathUtil::getTemporaryRomPath(config.temporary_folder.getOrThrow(),
 	config.output_rom.getOrThrow()) };
@@ -23,190 +26,242 @@ namespace callisto {
 
 		auto insertables{ buildOrderToInsertables(config) };
 
-		std::jthread init_thread;
-		std::jthread conflict_thread;
-		std::exception_ptr init_thread_exception{};
-		std::exception_ptr conflict_thread_exception{};
-		bool conflict_thread_created{ false };
-		if (!insertables.empty()) {
-			init_thread = std::jthread([&] { 
-				try {
-					insertables[0].second->init(); 
-				}
-				catch (...) {
-					init_thread_exception = std::current_exception();
-				}
-			});
-		}
-
 		std::shared_ptr<WriteMap> write_map{ std::make_shared<WriteMap>() };
-		auto old_rom{ std::make_shared<std::vector<char>>() };
-		auto new_rom{ std::make_shared<std::vector<char>>() };
 		Conflicts check_conflicts_policy{ determineConflictCheckSetting(config) };
+		const auto& project_root{ config.project_root.getOrThrow() };
 
+		// the ROM after every insertion, only kept until the conflict check is done with it
+		std::vector<std::shared_ptr<std::vector<char>>> rom_snapshots(insertables.size() + 1);
 		if (check_conflicts_policy != Conflicts::NONE) {
-			*old_rom = getRom(temp_rom_path);
+			rom_snapshots[0] = std::make_shared<std::vector<char>>(getRom(temp_rom_path));
 		}
 
-		size_t i{ 0 };
+		std::exception_ptr conflict_report_exception{};
 		std::optional<Insertable::NoDependencyReportFound> failed_dependency_report{};
-		for (const std::pair<const Descriptor&, std::shared_ptr<Insertable>> pair : insertables) {
-			init_thread.join();
-			if (init_thread_exception != nullptr) {
-				std::rethrow_exception(init_thread_exception);
+
+		// insertions happen one after another, an insertable's init runs once the insertion init_lookahead places 
+		// before it is done, so at most init_lookahead insertables are prepared but not yet inserted at a time, 
+		// and conflict checks trail behind their insertion, so all of these overlap
+		const size_t init_lookahead{ std::max<size_t>(1, config.init_lookahead.getOrDefault(DEFAULT_INIT_LOOKAHEAD)) };
+		const auto insertion_priority{ insertables.size() + 1 };
+		TaskGraph build_graph{};
+		std::vector<TaskGraph::TaskId> insert_tasks{};
+		std::optional<TaskGraph::TaskId> previous_conflict_task{};
+		// the task after which each earlier tool is done running, with the tool's working directory
+		std::vector<std::pair<TaskGraph::TaskId, fs::path>> tool_tasks{};
+		// module outputs only exist once the module is inserted and any tool can reach them through its .callisto file
+		std::vector<TaskGraph::TaskId> module_insert_tasks{};
+		// the insertion of every earlier patch, Lunar Magic insertable and so on, with the paths it reads if known
+		std::vector<std::pair<TaskGraph::TaskId, std::optional<std::vector<fs::path>>>> other_insert_tasks{};
+		const auto pathsOverlap{ [](const fs::path& a, const fs::path& b) {
+			return PathUtil::isWithin(a, b) || PathUtil::isWithin(b, a);
+		} };
+
+		for (size_t i{ 0 }; i != insertables.size(); ++i) {
+			const auto insertable{ insertables[i].second };
+			const auto& descriptor{ insertables[i].first };
+			const auto descriptor_string{ descriptor.toString(project_root) };
+
+			std::shared_ptr<ExternalTool> tool{};
+			if (descriptor.symbol == Symbol::EXTERNAL_TOOL) {
+				tool = static_pointer_cast<ExternalTool>(insertable);
 			}
-			if (i != insertables.size() - 1) {
-				init_thread = std::jthread([&] { 
-					try {
-						insertables[++i].second->init(); 
+
+			std::vector<TaskGraph::TaskId> init_dependencies{};
+			if (tool != nullptr && tool->runsAheadOfInsertion()) {
+				// tools that don't touch the ROM run in their init, which isn't held back by the lookahead, they 
+				// wait for all earlier modules, for earlier tools whose working directory overlaps theirs or one 
+				// of their static dependencies and for earlier insertions that read from there or whose inputs 
+				// we can't know before inserting, or for everything earlier if they declare no static dependencies,
+				// so the tool never changes a file an earlier entry in the build order still has to read
+				const auto& static_dependencies{ tool->getStaticDependencies() };
+				const auto overlapsTool{ [&](const fs::path& path) {
+					return pathsOverlap(tool->getWorkingDirectory(), path)
+						|| std::any_of(static_dependencies.begin(), static_dependencies.end(),
+						[&](const auto& static_dependency) {
+							return pathsOverlap(static_dependency.dependent_path, path);
+						});
+				} };
+				for (const auto& [tool_task, tool_working_directory] : tool_tasks) {
+					if (static_dependencies.empty() || overlapsTool(tool_working_directory)) {
+						init_dependencies.push_back(tool_task);
 					}
-					catch (...) {
-						init_thread_exception = std::current_exception();
+				}
+				for (const auto& [insert_task, input_paths] : other_insert_tasks) {
+					if (static_dependencies.empty() || !input_paths.has_value()
+						|| std::any_of(input_paths.value().begin(), input_paths.value().end(), overlapsTool)) {
+						init_dependencies.push_back(insert_task);
 					}
-				});
+				}
+				init_dependencies.insert(init_dependencies.end(), module_insert_tasks.begin(), module_insert_tasks.end());
 			}
+			else if (i >= init_lookahead) {
+				init_dependencies.push_back(insert_tasks[i - init_lookahead]);
+			}
+			const auto init_task{ build_graph.add("init " + descriptor_string, [insertable] {
+				insertable->init();
+			}, init_dependencies, insertables.size() - i) };
 
-			const auto insertable{ pair.second };
-			const auto& descriptor{ pair.first };
-
-			spdlog::info(fmt::format(colors::CALLISTO, "--- {} ---", descriptor.toString(config.project_root.getOrThrow())));
+			std::vector<TaskGraph::TaskId> insert_dependencies{ init_task };
+			if (i != 0) {
+				insert_dependencies.push_back(insert_tasks[i - 1]);
+			}
+			insert_tasks.push_back(build_graph.add("insert " + descriptor_string, [&, i, insertable, tool, descriptor, descriptor_string] {
+				spdlog::info(fmt::format(colors::CALLISTO, "--- {} ---", descriptor_string));
 
-			if (!failed_dependency_report.has_value()) {
-				const auto curr_path{ fs::current_path() };
-				std::unordered_set<ResourceDependency> resource_dependencies;
-				try {
-					resource_dependencies = insertable->insertWithDependencies();
-				}
-				catch (const Insertable::NoDependencyReportFound& e) {
-					failed_dependency_report = e;
-				}
-				catch (...) {
-					fs::current_path(curr_path);
+				if (!failed_dependency_report.has_value()) {
+					std::unordered_set<ResourceDependency> resource_dependencies;
 					try {
-						fs::remove_all(config.temporary_folder.getOrThrow());
+						resource_dependencies = insertable->insertWithDependencies();
 					}
-					catch (const std::runtime_error& e) {
-						spdlog::warn(fmt::format(colors::WARNING, "Failed to remove temporary folder '{}'",
-							config.temporary_folder.getOrThrow().string()));
+					catch (const Insertable::NoDependencyReportFound& e) {
+						failed_dependency_report = e;
 					}
-					throw;
-				}
-				spdlog::info("");
+					spdlog::info("");
 
-				if (descriptor.symbol == Symbol::PATCH) {
-					patch_hijacks.push_back(static_pointer_cast<Patch>(insertable)->getHijacks());
-				}
-				else {
-					patch_hijacks.push_back({});
-				}
+					if (descriptor.symbol == Symbol::PATCH) {
+						patch_hijacks.push_back(static_pointer_cast<Patch>(insertable)->getHijacks());
+					}
+					else {
+						patch_hijacks.push_back({});
+					}
 
-				if (!failed_dependency_report.has_value()) {
-					const auto config_dependencies{ insertable->getConfigurationDependencies() };
-					dependencies.push_back({ descriptor, { resource_dependencies, config_dependencies } });
+					if (descriptor.symbol == Symbol::LEVELS) {
+						level_fingerprints = static_pointer_cast<Levels>(insertable)->getFingerprints();
+					}
+					else if (descriptor.symbol == Symbol::GRAPHICS) {
+						graphics_fingerprints = static_pointer_cast<Graphics>(insertable)->getFingerprints();
+					}
+					else if (descriptor.symbol == Symbol::EX_GRAPHICS) {
+						exgraphics_fingerprints = static_pointer_cast<ExGraphics>(insertable)->getFingerprints();
+					}
+
+					if (!failed_dependency_report.has_value()) {
+						const auto config_dependencies{ insertable->getConfigurationDependencies() };
+						dependencies.push_back({ descriptor, { resource_dependencies, config_dependencies } });
+					}
 				}
-			}
-			else {
-				const auto curr_path{ fs::current_path() };
-				try {
+				else {
 					insertable->insert();
 					spdlog::info("");
 				}
-				catch (...) {
-					fs::current_path(curr_path);
-					try {
-						fs::remove_all(config.temporary_folder.getOrThrow());
+
+				if (check_conflicts_policy != Conflicts::NONE) {
+					// tools that ran ahead didn't touch the ROM, so there's no need to read it again
+					if (tool != nullptr && tool->runsAheadOfInsertion()) {
+						rom_snapshots[i + 1] = rom_snapshots[i];
 					}
-					catch (const std::runtime_error& e) {
-						spdlog::warn(fmt::format(colors::WARNING, "Failed to remove temporary folder '{}'",
-							config.temporary_folder.getOrThrow().string()));
+					else {
+						rom_snapshots[i + 1] = std::make_shared<std::vector<char>>(getRom(temp_rom_path));
 					}
-					throw;
 				}
+			}, insert_dependencies, insertion_priority));
+
+			if (tool != nullptr) {
+				tool_tasks.push_back({ tool->runsAheadOfInsertion() ? init_task : insert_tasks[i], tool->getWorkingDirectory() });
+			}
+			else if (descriptor.symbol == Symbol::MODULE) {
+				module_insert_tasks.push_back(insert_tasks[i]);
+			}
+			else {
+				other_insert_tasks.push_back({ insert_tasks[i], insertable->getKnownInputPaths() });
 			}
 
 			if (check_conflicts_policy != Conflicts::NONE) {
-				if (conflict_thread_created) {
-					conflict_thread.join();
-				}
-				else {
-					conflict_thread_created = true;
-				}
-
-				if (conflict_thread_exception != nullptr) {
-					std::rethrow_exception(conflict_thread_exception);
+				std::vector<TaskGraph::TaskId> conflict_dependencies{ insert_tasks[i] };
+				if (previous_conflict_task.has_value()) {
+					conflict_dependencies.push_back(previous_conflict_task.value());
 				}
-
-				*new_rom = getRom(temp_rom_path);
-				const fs::path project_root{ config.project_root.getOrThrow() };
-				conflict_thread = std::jthread([old_rom, new_rom, check_conflicts_policy, write_map, descriptor, project_root, &conflict_thread_exception] {
-					try {
-						updateWrites(old_rom, new_rom, check_conflicts_policy, write_map,
-							descriptor.toString(project_root));
-						old_rom->swap(*new_rom);
-					}
-					catch (...) {
-						conflict_thread_exception = std::current_exception();
-					}
-				});
-				// conflict_thread.join();
+				previous_conflict_task = build_graph.add("check conflicts " + descriptor_string, 
+					[&, i, descriptor_string] {
+					updateWrites(rom_snapshots[i], rom_snapshots[i + 1], check_conflicts_policy, write_map, descriptor_string);
+					rom_snapshots[i].reset();
+				}, conflict_dependencies);
 			}
 		}
 
-		if (conflict_thread_created) {
-			conflict_thread.join();
-		}
-
 		if (check_conflicts_policy != Conflicts::NONE) {
-			conflict_thread_created = true;
+			std::vector<TaskGraph::TaskId> report_dependencies{};
+			if (previous_conflict_task.has_value()) {
+				report_dependencies.push_back(previous_conflict_task.value());
+			}
 			const auto conflict_log_file{ config.conflict_log_file.isSet() ?
 						std::make_optional(config.conflict_log_file.getOrThrow()) :
 						std::nullopt };
-			const auto &ignored_symbols{ config.ignored_conflict_symbols };
-			const auto& project_root{ config.project_root.getOrThrow() };
-			conflict_thread = std::jthread([&conflict_thread_exception, write_map, conflict_log_file, check_conflicts_policy, ignored_symbols, project_root] {
+			build_graph.add("report conflicts", [&, conflict_log_file] {
+				// only worth a warning, the ROM itself is fine
 				try {
-					reportConflicts(write_map, conflict_log_file, check_conflicts_policy, conflict_thread_exception, 
-						ignored_symbols, project_root);
+					reportConflicts(write_map, conflict_log_file, check_conflicts_policy, conflict_report_exception, 
+						config.ignored_conflict_symbols, project_root);
 				}
 				catch (...) {
-					conflict_thread_exception = std::current_exception();
+					conflict_report_exception = std::current_exception();
 				}
-			});
+			}, report_dependencies);
 		}
 
-		if (!failed_dependency_report.has_value()) {
-			try {
-				const auto insertion_report{ getJsonDependencies(dependencies, patch_hijacks) };
+		std::vector<TaskGraph::TaskId> finish_dependencies{};
+		if (!insert_tasks.empty()) {
+			finish_dependencies.push_back(insert_tasks.back());
+		}
+		build_graph.add("finish ROM", [&] {
+			if (!failed_dependency_report.has_value()) {
+				try {
+					auto insertion_report{ getJsonDependencies(dependencies, patch_hijacks) };
+
+					for (auto& entry : insertion_report) {
+						const auto symbol{ Descriptor(entry["descriptor"]).symbol };
+						if (symbol == Symbol::LEVELS && level_fingerprints.has_value()) {
+							entry["mwl_fingerprints"] = level_fingerprints.value();
+						}
+						else if (symbol == Symbol::GRAPHICS && graphics_fingerprints.has_value()) {
+							entry["graphics_fingerprints"] = graphics_fingerprints.value();
+						}
+						else if (symbol == Symbol::EX_GRAPHICS && exgraphics_fingerprints.has_value()) {
+							entry["graphics_fingerprints"] = exgraphics_fingerprints.value();
+						}
+					}
 
-				writeBuildReport(config.project_root.getOrThrow(), createBuildReport(config, insertion_report));
+					writeBuildReport(project_root, createBuildReport(config, insertion_report));
+				}
+				catch (const std::exception& e) {
+					spdlog::warn(fmt::format(colors::WARNING, "Failed to write build report with following exception:\n\r{}", e.what()));
+				}
 			}
-			catch (const std::exception& e) {
-				spdlog::warn(fmt::format(colors::WARNING, "Failed to write build report with following exception:\n\r{}", e.what()));
+			else {
+				spdlog::info(fmt::format(colors::NOTIFICATION, "{}, Update not applicable, read the documentation "
+						"on details for how to set up Update correctly", failed_dependency_report.value().what()));
+				removeBuildReport(project_root);
 			}
-		}
-		else {
-			spdlog::info(fmt::format(colors::NOTIFICATION, "{}, Update not applicable, read the documentation "
-					"on details for how to set up Update correctly", failed_dependency_report.value().what()));
-			removeBuildReport(config.project_root.getOrThrow());
-		}
 
-		GraphicsUtil::linkOutputRomToProjectGraphics(config, false);
-		GraphicsUtil::linkOutputRomToProjectGraphics(config, true);
+			GraphicsUtil::linkOutputRomToProjectGraphics(config, false);
+			GraphicsUtil::linkOutputRomToProjectGraphics(config, true);
 
-		cacheModules(config.project_root.getOrThrow());
+			cacheModules(project_root);
 
-		Saver::writeMarkerToRom(temp_rom_path, config);
-		moveTempToOutput(config);
+			Saver::writeMarkerToRom(temp_rom_path, config);
+			moveTempToOutput(config);
+		}, finish_dependencies, insertion_priority);
 
-		const auto build_end{ std::chrono::high_resolution_clock::now() };
-
-		if (conflict_thread_created) {
-			conflict_thread.join();
+		try {
+			build_graph.run();
 		}
+		catch (...) {
+			try {
+				fs::remove_all(config.temporary_folder.getOrThrow());
+			}
+			catch (const std::runtime_error& e) {
+				spdlog::warn(fmt::format(colors::WARNING, "Failed to remove temporary folder '{}'",
+					config.temporary_folder.getOrThrow().string()));
+			}
+			throw;
+		}
+
+		const auto build_end{ std::chrono::high_resolution_clock::now() };
 
-		if (conflict_thread_exception != nullptr) {
+		if (conflict_report_exception != nullptr) {
 			try {
-				std::rethrow_exception(conflict_thread_exception);
+				std::rethrow_exception(conflict_report_exception);
 			}
 			catch (const std::exception& e) {
 				spdlog::warn(fmt::format(colors::WARNING, "The following error occurred while attempting to report conflicts:\n\r{}", e.what()));
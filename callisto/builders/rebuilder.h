@@ -9,6 +9,7 @@
 #include "builder.h"
 #include "../configuration/configuration.h"
 #include "../insertables/initial_patch.h"
+#include "../task_graph.h"
 
 namespace callisto {
 	class Rebuilder : public Builder {
@@ -18,6 +19,8 @@ namespace callisto {
 		using ConflictVector = std::vector<std::pair<std::string, std::vector<unsigned char>>>;
 		using PatchHijacksVector = std::vector<std::optional<std::vector<std::pair<size_t, size_t>>>>;
 
+		static constexpr size_t DEFAULT_INIT_LOOKAHEAD{ 4 };
+
 		enum class Conflicts {
 			NONE,
 			HIJACKS,
@@ -16,6 +16,7 @@ namespace callisto {
 		app.require_subcommand(1, 1);
 
 		std::optional<size_t> max_thread_count;
+		std::optional<size_t> process_timeout;
 		bool allow_user_input{ true };
 		bool check_for_pending_save{ true };
 
@@ -25,6 +26,12 @@ namespace callisto {
 			"Maximum number of threads to use"
 		);
 
+		app.add_option(
+			"--process-timeout",
+			process_timeout,
+			"Seconds after which external programs like Lunar Magic are stopped if they haven't finished (default is no limit)"
+		);
+
 		app.add_option(
 			"--allow-user-input",
 			allow_user_input,
@@ -42,6 +49,10 @@ namespace callisto {
 				globals::setMaxThreadCount(max_thread_count.value());
 			}
 
+			if (process_timeout.has_value()) {
+				globals::PROCESS_TIMEOUT = std::chrono::seconds(process_timeout.value());
+			}
+
 			globals::ALLOW_USER_INPUT = allow_user_input;
 		} };
 
@@ -174,6 +185,14 @@ namespace callisto {
 			"The profile to save with"
 		);
 
+		std::vector<std::string> save_levels{};
+		save_sub->add_option(
+			"-l,--level",
+			save_levels,
+			"Number of a level to export in hex, can be passed multiple times, exports only these levels instead of everything "
+			"and leaves the ROM marked as unsaved"
+		);
+
 		save_sub->callback([&] {
 			init();
 			const auto config{ config_manager.getConfiguration(profile_name) };
@@ -186,6 +205,28 @@ namespace callisto {
 				}
 			}
 #endif
+			if (!save_levels.empty()) {
+				std::vector<int> level_numbers{};
+				for (const auto& level : save_levels) {
+					size_t parsed{};
+					int level_number{};
+					try {
+						level_number = std::stoi(level, &parsed, 16);
+					}
+					catch (...) {
+						parsed = 0;
+					}
+
+					if (parsed != level.size() || level_number < 0 || level_number >= 0x200) {
+						throw std::runtime_error(fmt::format("'{}' is not a valid level number", level));
+					}
+					level_numbers.push_back(level_number);
+				}
+
+				Saver::exportLevels(config->output_rom.getOrThrow(), *config, level_numbers);
+				exit(0);
+			}
+
 			Saver::exportResources(config->output_rom.getOrThrow(), *config, true);
 			exit(0);
 		});
@@ -208,30 +249,45 @@ namespace callisto {
 			exit(0);
 		});
 
+		std::vector<std::string> package_profile_names{};
 		package_sub->add_option(
 			"-p,--profile",
-			profile_name,
-			"The profile to package with"
+			package_profile_names,
+			"The profile to package with, can be passed multiple times to package several profiles at once"
+		);
+
+		bool package_all_profiles{ false };
+		package_sub->add_flag(
+			"--all-profiles",
+			package_all_profiles,
+			"Packages every profile"
 		);
 
 		package_sub->callback([&] {
 			init();
-			const auto config{ config_manager.getConfiguration(profile_name) };
 
-			const auto exit_code{ bp::system(
-				config->flips_path.getOrThrow().string(), "--create", "--bps-delta", config->clean_rom.getOrThrow().string(),
-				config->output_rom.getOrThrow().string(), config->bps_package.getOrThrow().string(), bp::std_out > bp::null
-			) };
+			if (package_all_profiles) {
+				package_profile_names = config_manager.getProfileNames();
+			}
 
-			if (exit_code != 0) {
-				throw std::runtime_error(fmt::format("Failed to create package of '{}' at '{}'",
-					config->output_rom.getOrThrow().string(),
-					config->bps_package.getOrThrow().string()
-				));
+			std::vector<std::shared_ptr<Configuration>> configs{};
+			if (package_profile_names.empty()) {
+				configs.push_back(config_manager.getConfiguration({}));
+			}
+			for (const auto& name : package_profile_names) {
+				configs.push_back(config_manager.getConfiguration(name));
 			}
 
-			spdlog::info("Successfully created package of '{}' at '{}'", 
-				config->output_rom.getOrThrow().string(), config->bps_package.getOrThrow().string());
+			for (const auto& result : Packager::package(configs)) {
+				if (result.reused) {
+					spdlog::info("Package of '{}' at '{}' is already up to date",
+						result.output_rom.string(), result.package.string());
+				}
+				else {
+					spdlog::info("Successfully created package of '{}' at '{}'",
+						result.output_rom.string(), result.package.string());
+				}
+			}
 
 			exit(0);
 		});
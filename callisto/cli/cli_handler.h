@@ -14,6 +14,8 @@
 
 #include "../globals.h"
 
+#include "../packager/packager.h"
+
 #include "../lunar_magic/lunar_magic_wrapper.h"
 
 namespace fs = std::filesystem;
@@ -417,6 +417,7 @@ namespace callisto {
 		trySet(level_import_flag, config_file, level, user_variables);
 
 		trySet(check_conflicts, config_file, level, user_variables);
+		trySet(bps_effort, config_file, level, user_variables);
 		trySet(conflict_log_file, config_file, level, root, user_variables);
 		ignored_conflict_symbol_strings.trySet(config_file, level, user_variables);
 
@@ -443,6 +444,9 @@ namespace callisto {
 		trySet(enable_automatic_reloads, config_file, level);
 
 		trySet(enable_multithreaded_level_export, config_file, level);
+		trySet(reserve_module_freespace, config_file, level);
+		trySet(incremental_level_export, config_file, level);
+		init_lookahead.trySet(config_file, level);
 
 		trySet(disable_deprecation_warnings, config_file, level);
 
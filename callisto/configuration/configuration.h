@@ -109,6 +109,7 @@ namespace callisto {
 		PathConfigVariable log_file{ {"settings", "log_file"} };
 		PathConfigVariable clean_rom{ {"settings", "clean_rom"} };
 		StringConfigVariable check_conflicts{ {"settings", "check_conflicts"} };
+		StringConfigVariable bps_effort{ {"settings", "bps_effort"} };
 		PathConfigVariable conflict_log_file { {"settings", "conflict_log_file"} };
 		StringVectorConfigVariable ignored_conflict_symbol_strings{ {"settings", "ignored_conflict_symbols"} };
 
@@ -117,6 +118,9 @@ namespace callisto {
 		BoolConfigVariable enable_automatic_reloads{ {"settings", "enable_automatic_reloads"} };
 		BoolConfigVariable enable_automatic_exports{ {"settings", "enable_automatic_exports"} };
 		BoolConfigVariable enable_multithreaded_level_export{ {"settings", "enable_multithreaded_level_export"} };
+		BoolConfigVariable reserve_module_freespace{ {"settings", "reserve_module_freespace"} };
+		BoolConfigVariable incremental_level_export{ {"settings", "incremental_level_export"} };
+		IntegerConfigVariable init_lookahead{ {"settings", "init_lookahead"} };
 
 		BoolConfigVariable prefer_user_clean_rom{ {"settings", "prefer_user_clean_rom" } };
 
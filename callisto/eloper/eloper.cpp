@@ -150,9 +150,13 @@ LRESULT CALLBACK wndProc(HWND hwnd, UINT umsg, WPARAM wparam, LPARAM lparam) {
 				handleNewRom((HWND)wparam);
 				break;
 
-			case LunarMagicNotificationType::DELETE_LEVEL:
-				[[fallthrough]];
 			case LunarMagicNotificationType::SAVE_LEVEL:
+				// only the saved level changed, so that's all we need to export
+				thr = std::thread([level_number = static_cast<int>(wparam & 0x1FF)] { handleSave(level_number); });
+				thr.detach();
+				break;
+
+			case LunarMagicNotificationType::DELETE_LEVEL:
 				[[fallthrough]];
 			case LunarMagicNotificationType::SAVE_MAP16:
 				[[fallthrough]];
@@ -265,7 +269,7 @@ std::optional<std::string> determineSaveProfile(const fs::path& callisto_directo
 	}
 }
 
-void handleSave() {
+void handleSave(std::optional<int> level_number) {
 	const auto profile{ determineSaveProfile(callisto_path.parent_path()) };
 
 	if (!trySetConfig(profile)) {
@@ -298,6 +302,8 @@ void handleSave() {
 	if (callisto_save_process_pid.has_value()) {
 		cancel = true;
 		spdlog::info("Thread {}: Sending cancel", id, callisto_save_process_pid.value());
+		// whatever the cancelled save was exporting still needs to be exported, so do everything
+		level_number = std::nullopt;
 	}
 
 	std::scoped_lock lock(m);
@@ -309,27 +315,24 @@ void handleSave() {
 	
 	// just going with a single thread, speed probably doesn't matter much on automated saves, I'd guess
 	const auto thread_count{ "1" };
+	std::vector<std::string> save_args{ "save" };
 	if (profile.has_value()) {
-		new_save_process = bp::child(
-			callisto_path.string(), "save", 
-			"--profile", profile.value(), 
-			"--max-threads", thread_count, 
-			"--allow-user-input", "false",
-			"--check-pending-save", "false",
-			bp::std_out > output, bp::windows::create_no_window, g
-		);
+		save_args.insert(save_args.end(), { "--profile", profile.value() });
 	}
-	else {
-		new_save_process = bp::child(
-			callisto_path.string(), 
-			"save", 
-			"--max-threads", thread_count,
-			"--allow-user-input", "false",
-			"--check-pending-save", "false",
-			bp::std_out > output, bp::windows::create_no_window, g
-		);
+	save_args.insert(save_args.end(), {
+		"--max-threads", thread_count,
+		"--allow-user-input", "false",
+		"--check-pending-save", "false"
+	});
+	if (level_number.has_value()) {
+		save_args.insert(save_args.end(), { "--level", fmt::format("{:X}", level_number.value()) });
 	}
 
+	new_save_process = bp::child(
+		callisto_path.string(), bp::args(save_args),
+		bp::std_out > output, bp::windows::create_no_window, g
+	);
+
 	spdlog::info("Thread {}: Started new save process {:X}", id, new_save_process.id());
 	process_info.setSaveProcessPid(g.native_handle());
 
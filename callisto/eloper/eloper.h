@@ -7,6 +7,8 @@
 #include <utility>
 #include <unordered_set>
 #include <thread>
+#include <optional>
+#include <vector>
 
 #include <boost/process.hpp>
 #include <boost/process/windows.hpp>
@@ -60,7 +62,7 @@ bp::pid_t getLunarMagicPid(HWND message_window_handle);
 bool trySetConfig(const fs::path& callisto_directory);
 
 void handleNewRom(HWND message_window_hwnd);
-void handleSave();
+void handleSave(std::optional<int> level_number = std::nullopt);
 
 std::optional<std::string> getLastConfigName(const fs::path& callisto_directory);
 std::optional<std::string> determineSaveProfile(const fs::path& callisto_directory);
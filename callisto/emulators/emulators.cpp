@@ -27,7 +27,7 @@ namespace callisto {
 			throw NotFoundException(fmt::format("Emulator {} not found at {}", emulator_name, emulator_path));
 		}
 
-		bp::spawn(fmt::format(
+		Subprocess::launchDetached(fmt::format(
 			"\"{}\" {} \"{}\"",
 			emulator_path,
 			emulator.options.getOrDefault(""),
@@ -3,15 +3,13 @@
 #include <filesystem>
 #include <vector>
 
-#include <boost/process.hpp>
-#include <boost/process/spawn.hpp>
 #include <fmt/format.h>
 
 #include "../configuration/emulator_configuration.h"
 #include "../configuration/configuration.h"
+#include "../subprocess.h"
 
 namespace fs = std::filesystem;
-namespace bp = boost::process;
 
 namespace callisto {
 	class Emulators {
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <string>
+
+#include "subprocess.h"
+#include "configuration/configuration.h"
+
+namespace fs = std::filesystem;
+
+namespace callisto {
+	// Where a piece of work happens, passed along explicitly instead of changing the process' working directory,
+	// which is shared by every thread, so work happening in different directories can run at the same time
+	class ExecutionContext {
+	public:
+		// relative paths are resolved against this
+		const fs::path base_directory;
+		const fs::path temporary_directory;
+		// variables set for programs started in this context on top of our own environment
+		const std::map<std::string, std::string> environment;
+
+		ExecutionContext(const fs::path& base_directory, const fs::path& temporary_directory,
+			const std::map<std::string, std::string>& environment = {})
+			: base_directory(fs::absolute(base_directory)), temporary_directory(fs::absolute(temporary_directory)),
+			environment(environment) {}
+
+		// The project's context, based in the project root and using the configured temporary folder
+		explicit ExecutionContext(const Configuration& config)
+			: ExecutionContext(config.project_root.getOrThrow(), config.temporary_folder.getOrThrow()) {}
+
+		fs::path resolve(const fs::path& path) const {
+			return path.is_absolute() ? path : base_directory / path;
+		}
+
+		// The same context with a different base directory, a relative directory is resolved against the current one
+		ExecutionContext withBaseDirectory(const fs::path& directory) const {
+			return ExecutionContext(resolve(directory), temporary_directory, environment);
+		}
+
+		// Programs started with these options run in the base directory with the context's environment
+		Subprocess::Options subprocessOptions() const {
+			Subprocess::Options options{};
+			options.working_directory = base_directory;
+			options.environment = environment;
+			return options;
+		}
+	};
+}
@@ -3,7 +3,9 @@
 namespace callisto {
 	namespace extractables {
 		BinaryMap16::BinaryMap16(const Configuration& config, const fs::path& extracting_rom)
-			: LunarMagicExtractable(config, extracting_rom), map16_file_path(config.map16.getOrThrow()) {}
+			: LunarMagicExtractable(config, extracting_rom), map16_file_path(config.map16.getOrThrow()),
+			temporary_map16_file_path(PathUtil::getTemporaryResourcePathFor(config.temporary_folder.getOrThrow(), 
+				map16_file_path.filename())) {}
 
 		void BinaryMap16::extract() {
 			spdlog::info(fmt::format(colors::RESOURCE, "Exporting Map16"));
@@ -16,10 +18,11 @@ namespace callisto {
 			const auto exit_code{ callLunarMagic(
 				"-ExportAllMap16",
 				extracting_rom.string(),
-				map16_file_path.string())
+				temporary_map16_file_path.string())
 			};
 
 			if (exit_code == 0) {
+				output_writer.moveInto(temporary_map16_file_path, map16_file_path);
 				spdlog::info(fmt::format(colors::PARTIAL_SUCCESS, "Successfully exported Map16!"));
 			}
 			else {
@@ -6,6 +6,7 @@
 
 #include "lunar_magic_extractable.h"
 #include "extraction_exception.h"
+#include "../path_util.h"
 
 namespace fs = std::filesystem;
 
@@ -14,6 +15,7 @@ namespace callisto {
 		class BinaryMap16 : public LunarMagicExtractable {
 		protected:
 			const fs::path map16_file_path;
+			const fs::path temporary_map16_file_path;
 
 		public:
 			void extract() override;
@@ -11,7 +11,7 @@ namespace callisto {
 			const auto keep_symlink{ extracting_rom == config.output_rom.getOrThrow() };
 
 			try {
-				GraphicsUtil::exportProjectExGraphicsFrom(config, extracting_rom, keep_symlink);
+				GraphicsUtil::exportProjectExGraphicsFrom(config, extracting_rom, output_writer, keep_symlink);
 			}
 			catch (const std::exception& e) {
 				throw ExtractionException(fmt::format(
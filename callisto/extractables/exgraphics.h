@@ -25,6 +25,10 @@ namespace callisto {
 		public:
 			void extract() override;
 
+			size_t getCost() const override {
+				return 5;
+			}
+
 			ExGraphics(const Configuration& config, const fs::path& extracting_rom);
 		};
 	}
@@ -1,10 +1,23 @@
 #pragma once
 
 #include "../colors.h"
+#include "output_writer.h"
 
 namespace callisto {
 	class Extractable {
+	protected:
+		extractables::OutputWriter output_writer{};
+
 	public:
 		virtual void extract() = 0;
+
+		// Rough amount of work extract() does relative to other extractables, the most expensive ones are started first
+		virtual size_t getCost() const {
+			return 1;
+		}
+
+		size_t getChangedFileCount() const {
+			return output_writer.getChangedFileCount();
+		}
 	};
 }
@@ -2,17 +2,9 @@
 
 namespace callisto {
 	FlipsExtractable::FlipsExtractable(const Configuration& config, const fs::path& output_patch_path, const fs::path& extracting_rom)
-		: LunarMagicExtractable(config, extracting_rom), flips_executable(config.flips_path.getOrThrow()),
-		clean_rom_path(config.clean_rom.getOrThrow()),
-		output_patch_path(output_patch_path) {
-
-		if (!fs::exists(flips_executable)) {
-			throw ToolNotFoundException(fmt::format(
-				colors::EXCEPTION,
-				"FLIPS not found at {}",
-				flips_executable.string()
-			));
-		}
+		: LunarMagicExtractable(config, extracting_rom), clean_rom_path(config.clean_rom.getOrThrow()),
+		bps_effort(Bps::parseEffort(config.bps_effort.getOrDefault("balanced"))),
+		output_patch_path(output_patch_path), project_root(config.project_root.getOrThrow()) {
 
 		if (!fs::exists(clean_rom_path)) {
 			throw NotFoundException(fmt::format(
@@ -38,34 +30,82 @@ namespace callisto {
 			+ extracting_rom.extension().string());
 	}
 
-	void FlipsExtractable::createTemporaryResourceRom(const fs::path& temporary_resource_rom) const {
-		spdlog::debug("Copying clean ROM from {} to {}", clean_rom_path.string(), temporary_resource_rom.string());
+	fs::path FlipsExtractable::getExpandedCleanRom() const {
+		std::scoped_lock lock(expanded_clean_rom_mutex);
+
+		const auto expanded_rom_path{ PathUtil::getExpandedCleanRomPath(project_root, clean_rom_path.extension()) };
+		auto key_path{ expanded_rom_path };
+		key_path.replace_extension(".json");
+
+		// Lunar Magic doesn't report its version, its executable changes whenever the version does though
+		const json key{
+			{ "clean_rom", HashUtil::hashFile(clean_rom_path) },
+			{ "lunar_magic", HashUtil::hashFile(lunar_magic_executable) }
+		};
+
+		if (fs::exists(expanded_rom_path) && fs::exists(key_path)) {
+			try {
+				std::ifstream key_file{ key_path };
+				if (json::parse(key_file) == key) {
+					spdlog::debug("Reusing expanded clean ROM {}", expanded_rom_path.string());
+					return expanded_rom_path;
+				}
+			}
+			catch (const json::exception&) {
+				// expanding it again below
+			}
+		}
+
+		fs::create_directories(expanded_rom_path.parent_path());
+		fs::remove(key_path);
+
+		spdlog::debug("Copying clean ROM from {} to {}", clean_rom_path.string(), expanded_rom_path.string());
 		try {
-			fs::copy_file(clean_rom_path, temporary_resource_rom, fs::copy_options::overwrite_existing);
+			fs::copy_file(clean_rom_path, expanded_rom_path, fs::copy_options::overwrite_existing);
 		}
 		catch (const fs::filesystem_error& e) {
 			throw ExtractionException(fmt::format(
 				colors::EXCEPTION,
 				"Failed to copy clean ROM from {} to {}",
-				clean_rom_path.string(), temporary_resource_rom.string()
+				clean_rom_path.string(), expanded_rom_path.string()
 			));
 		}
 
-		spdlog::debug("Expanding temporary resource ROM {} to 4MB", temporary_resource_rom.string());
-		const auto exit_code{ bp::system(
-			lunar_magic_executable.string(),
+		spdlog::debug("Expanding clean ROM copy {} to 4MB", expanded_rom_path.string());
+		const auto exit_code{ callLunarMagic(
 			"-ExpandROM",
-			temporary_resource_rom.string(),
+			expanded_rom_path.string(),
 			"4MB"
 		) };
 
 		if (exit_code == 0) {
 			spdlog::debug("Successfully expanded ROM");
+			std::ofstream key_file{ key_path };
+			key_file << std::setw(4) << key << std::endl;
 		}
 		else {
-			spdlog::warn(fmt::format(colors::WARNING, "Failed to expand temporary resource ROM at {} using Lunar Magic at {}, "
+			// not caching it, so the next save tries again
+			spdlog::warn(fmt::format(colors::WARNING, "Failed to expand clean ROM copy at {} using Lunar Magic at {}, "
 				"if your {} data is large, you may get a Lunar Magic popup at some point",
-				temporary_resource_rom.string(), lunar_magic_executable.string(), getResourceName()));
+				expanded_rom_path.string(), lunar_magic_executable.string(), getResourceName()));
+		}
+
+		return expanded_rom_path;
+	}
+
+	void FlipsExtractable::createTemporaryResourceRom(const fs::path& temporary_resource_rom) const {
+		const auto expanded_rom_path{ getExpandedCleanRom() };
+
+		spdlog::debug("Copying expanded clean ROM from {} to {}", expanded_rom_path.string(), temporary_resource_rom.string());
+		try {
+			FileUtil::cloneFile(expanded_rom_path, temporary_resource_rom);
+		}
+		catch (const fs::filesystem_error& e) {
+			throw ExtractionException(fmt::format(
+				colors::EXCEPTION,
+				"Failed to copy expanded clean ROM from {} to {}",
+				expanded_rom_path.string(), temporary_resource_rom.string()
+			));
 		}
 	}
 
@@ -87,27 +127,29 @@ namespace callisto {
 		}
 	}
 
-	void FlipsExtractable::createOutputPatch(const fs::path& temporary_resource_rom) const {
+	void FlipsExtractable::createOutputPatch(const fs::path& temporary_resource_rom) {
 		spdlog::debug("Creating output patch {} from temporary ROM {}",
 			output_patch_path.string(), temporary_resource_rom.string());
 
-		const auto exit_code{ bp::system(
-			flips_executable.string(), "--create", "--bps-delta", clean_rom_path.string(), 
-			temporary_resource_rom.string(), output_patch_path.string()
-		) };
+		// patch creation is deterministic, so if the resource didn't change the patch comes out byte for byte the same
+		auto temporary_patch_path{ temporary_resource_rom };
+		temporary_patch_path.replace_extension(".bps");
 
-		if (exit_code == 0) {
-			spdlog::debug("Successfully created patch {} from temporary ROM {}",
-				output_patch_path.string(),  temporary_resource_rom.string());
-			spdlog::info(fmt::format(colors::PARTIAL_SUCCESS, "Successfully exported {}!", getResourceName()));
+		try {
+			Bps::createFile(clean_rom_path, temporary_resource_rom, temporary_patch_path, bps_effort);
 		}
-		else {
+		catch (const BpsException& e) {
 			throw ExtractionException(fmt::format(
 				colors::EXCEPTION,
-				"Failed to create BPS patch {} from temporary ROM {}",
-				output_patch_path.string(), temporary_resource_rom.string()
+				"Failed to create BPS patch {} from temporary ROM {}: {}",
+				output_patch_path.string(), temporary_resource_rom.string(), e.what()
 			));
 		}
+
+		const auto changed{ output_writer.moveInto(temporary_patch_path, output_patch_path) };
+		spdlog::debug("Successfully created patch {} from temporary ROM {}{}",
+			output_patch_path.string(),  temporary_resource_rom.string(), changed ? "" : ", patch unchanged");
+		spdlog::info(fmt::format(colors::PARTIAL_SUCCESS, "Successfully exported {}!", getResourceName()));
 	}
 
 	void FlipsExtractable::deleteTemporaryResourceRom(const fs::path& temporary_resource_rom) const {
@@ -1,31 +1,54 @@
 #pragma once
 
+#include <mutex>
+#include <fstream>
+#include <iomanip>
+
 #include <fmt/format.h>
+#include <nlohmann/json.hpp>
 
 #include "lunar_magic_extractable.h"
 #include "extraction_exception.h"
+#include "../bps/bps.h"
+#include "../file_util.h"
+#include "../hash_util.h"
+#include "../path_util.h"
+
+using json = nlohmann::json;
 
 namespace callisto {
 	class FlipsExtractable : public LunarMagicExtractable {
 	protected:
-		const fs::path flips_executable;
 		const fs::path clean_rom_path;
+		const Bps::Effort bps_effort;
 		const fs::path output_patch_path;
+		const fs::path project_root;
+
+		// all FLIPS extractables start from the same expanded clean ROM, only one of them should create it
+		inline static std::mutex expanded_clean_rom_mutex{};
 
 		virtual inline std::string getTemporaryResourceRomPostfix() const = 0;
 		virtual inline std::string getLunarMagicFlag() const = 0;
 		virtual inline std::string getResourceName() const = 0;
 
 		fs::path getTemporaryResourceRomPath() const;
+		// Returns the clean ROM expanded to 4MB, it is kept in the cache and only expanded again
+		// once the clean ROM or Lunar Magic changes
+		fs::path getExpandedCleanRom() const;
 
 		void createTemporaryResourceRom(const fs::path& temporary_resource_rom) const;
 		void invokeLunarMagic(const fs::path& temporary_resource_rom) const;
-		void createOutputPatch(const fs::path& temporary_resource_rom) const;
+		void createOutputPatch(const fs::path& temporary_resource_rom);
 		void deleteTemporaryResourceRom(const fs::path& temporary_resource_rom) const;
 
 	public:
 		FlipsExtractable(const Configuration& config, const fs::path& output_patch_path, const fs::path& extracting_rom);
 
 		void extract() override;
+
+		// a Lunar Magic transfer followed by creating a patch
+		size_t getCost() const override {
+			return 4;
+		}
 	};
 }
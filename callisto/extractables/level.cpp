@@ -3,7 +3,9 @@
 namespace callisto {
 	namespace extractables {
 		Level::Level(const Configuration& config, const fs::path& mwl_file, int level_number, const fs::path& extracting_rom)
-			: LunarMagicExtractable(config, extracting_rom), mwl_file(mwl_file), level_number(level_number) {
+			: LunarMagicExtractable(config, extracting_rom), mwl_file(mwl_file), 
+			export_path(PathUtil::getTemporaryResourcePathFor(config.temporary_folder.getOrThrow(), "level_exports") / mwl_file.filename()),
+			level_number(level_number) {
 			if (!fs::exists(mwl_file.parent_path())) {
 				spdlog::debug("Levels directory {} does not exist, creating it now", mwl_file.parent_path().string());
 
@@ -36,80 +38,6 @@ namespace callisto {
 			return comb;
 		}
 
-		std::pair<bool, uint8_t> Level::determineSkip(const std::vector<unsigned char>& bytes, unsigned int offset) {
-			const auto standard_id{ getStandardObjectId(bytes, offset) };
-
-			if (standard_id == 0x0) {
-				const auto extended_no{ getExtendedObjectNumber(bytes, offset) };
-				if (extended_no == 0x0) {
-					// screen exit
-					return { true, 4 };
-				}
-				if (extended_no == 0x2) {
-					// extended screen exit
-					return { true, 5 };
-				}
-				// normal extended object
-				return { false, 3 };
-			}
-			if (standard_id == 0x22 || standard_id == 0x23) {
-				return { false, 4 };
-			}
-			if (standard_id == 0x24 || standard_id == 0x25) {
-				return { false, 3 };
-			}
-			if (standard_id == 0x26) {
-				return { false, 3 };
-			}
-			if (standard_id == 0x27 || standard_id == 0x29) {
-				return { false, get27_29Size(bytes, offset) };
-			}
-			if (standard_id == 0x28) {
-				return { false, 3 } ;
-			}
-			if (standard_id == 0x2D) {
-				return { false, 5 };
-			}
-			return { false, 3 };
-		}
-
-		uint8_t Level::getStandardObjectId(const std::vector<unsigned char>& bytes, unsigned int offset) {
-			const auto two{ bytesToInt(bytes, offset, 2) };
-			const auto high{ (two & 0x6000) >> 9 };
-			const auto low{ (two & 0x00F0) >> 4 };
-			return high | low;
-		}
-
-		uint8_t Level::getExtendedObjectNumber(const std::vector<unsigned char>& bytes, unsigned int offset) {
-			return bytesToInt(bytes, offset + 2, 1);
-		}
-
-		uint8_t Level::get27_29Size(const std::vector<unsigned char>& bytes, unsigned int offset) {
-			const auto rel_byte_1{ bytesToInt(bytes, offset + 3, 1) };
-			const auto masked{ (rel_byte_1 & 0b11000000) >> 6 };
-			if (masked != 0b11) {
-				if (masked == 0b00) {
-					return 5;
-				}
-				else if (masked == 0b01) {
-					return 5;
-				}
-				else {
-					return 6;
-				}
-			}
-			else {
-				const auto rel_byte_2{ bytesToInt(bytes, offset + 2, 1) };
-				const auto masked_2{ (rel_byte_2 & 0b10000000) >> 7 };
-				if (masked_2 == 0b0) {
-					return 7;
-				}
-				else {
-					return 8;
-				}
-			}
-		}
-
 		void Level::writeFourBytes(std::vector<unsigned char>& mwl, unsigned int offset, unsigned int bytes) {
 			mwl[offset] = (bytes >> 24) & 0xFF;
 			mwl[offset + 1] = (bytes >> 16) & 0xFF;
@@ -126,33 +54,57 @@ namespace callisto {
 		}
 
 		void Level::extract() {
-			spdlog::info(fmt::format(colors::RESOURCE, "Exporting level {} to file {}", level_number, mwl_file.string()));
-			spdlog::debug("Exporting level {} from ROM {} to file {}",
+			spdlog::info(fmt::format(colors::RESOURCE, "Exporting level {:03X} to file {}", level_number, mwl_file.string()));
+			spdlog::debug("Exporting level {:03X} from ROM {} to file {}",
 				level_number, extracting_rom.string(), mwl_file.string());
 
+			// Lunar Magic expects level numbers in hex, same as everywhere else
+			fs::create_directories(export_path.parent_path());
 			const auto exit_code{ callLunarMagic("-ExportLevel", extracting_rom.string(),
-				mwl_file.string(), std::to_string(level_number)) };
+				export_path.string(), fmt::format("{:X}", level_number)) };
 
 			if (exit_code == 0) {
-				if (strip_source_pointers) {
-					normalize(mwl_file);
-				}
-				spdlog::info(fmt::format(colors::PARTIAL_SUCCESS, "Successfully exported level {} to {}", level_number, mwl_file.string()));
+				moveExported(export_path, mwl_file, strip_source_pointers, output_writer);
+				spdlog::info(fmt::format(colors::PARTIAL_SUCCESS, "Successfully exported level {:03X} to {}", level_number, mwl_file.string()));
 			}
 			else {
 				throw ExtractionException(fmt::format(
 					colors::EXCEPTION,
-					"Failed to export level {} from ROM {} to {}", level_number, extracting_rom.string(), mwl_file.string()
+					"Failed to export level {:03X} from ROM {} to {}", level_number, extracting_rom.string(), mwl_file.string()
 				));
 			}
 		}
 
+		bool Level::moveExported(const fs::path& exported_path, const fs::path& target_path, bool strip_source_pointers,
+			OutputWriter& output_writer) {
+			const auto exported_bytes{ FileUtil::readAll(exported_path) };
+			std::vector<unsigned char> mwl_bytes(exported_bytes.begin(), exported_bytes.end());
+
+			if (strip_source_pointers) {
+				normalize(mwl_bytes, target_path);
+			}
+
+			const auto written{ output_writer.write(
+				std::string_view(reinterpret_cast<const char*>(mwl_bytes.data()), mwl_bytes.size()), target_path) };
+			fs::remove(exported_path);
+
+			if (!written) {
+				spdlog::debug("MWL file {} did not change", target_path.string());
+			}
+			return written;
+		}
+
 		void Level::normalize(const fs::path& mwl_path) {
-			spdlog::debug("Stripping layer 1, layer 2, sprite and palette source addresses from MWL file {}", mwl_path.string());
+			const auto file_bytes{ FileUtil::readAll(mwl_path) };
+			std::vector<unsigned char> mwl_bytes(file_bytes.begin(), file_bytes.end());
 
-			std::ifstream mwl_file(mwl_path, std::ios::in | std::ios::binary);
-			std::vector<uint8_t> mwl_bytes((std::istreambuf_iterator<char>(mwl_file)), (std::istreambuf_iterator<char>()));
-			mwl_file.close();
+			normalize(mwl_bytes, mwl_path);
+
+			FileUtil::writeIfDifferent(std::string_view(reinterpret_cast<const char*>(mwl_bytes.data()), mwl_bytes.size()), mwl_path);
+		}
+
+		void Level::normalize(std::vector<unsigned char>& mwl_bytes, const fs::path& mwl_path) {
+			spdlog::debug("Stripping layer 1, layer 2, sprite and palette source addresses from MWL file {}", mwl_path.string());
 
 			const auto data_pointer_table_offset{ fourBytesToInt(mwl_bytes, MWL_HEADER_POINTER_OFFSET) };
 			
@@ -208,7 +160,7 @@ namespace callisto {
 			std::vector<bool> has_new_screen_set_five{};
 			auto curr_offset{ fourBytesToInt(mwl_bytes, data_pointer_table_offset + MWL_L1_DATA_POINTER_OFFSET) + 13 };
 			while (bytesToInt(mwl_bytes, curr_offset, 1) != 0xFF) {
-				const auto skippage{ determineSkip(mwl_bytes, curr_offset) };
+				const auto skippage{ LevelRomData::determineSkip(mwl_bytes, curr_offset) };
 				const auto& is_screen_exit{ skippage.first };
 				const auto& skip_value{ skippage.second };
 
@@ -249,10 +201,6 @@ namespace callisto {
 				const auto masked{ !has_new_screen_set_five.at(i) ? exit : exit | 0x8000000000 };
 				writeFiveBytes(mwl_bytes, screen_exit_indices_five.at(i++), masked);
 			}
-
-			std::ofstream out_mwl_file(mwl_path, std::ios::out | std::ios::binary);
-			out_mwl_file.write(reinterpret_cast<const char*>(mwl_bytes.data()), mwl_bytes.size());
-			out_mwl_file.close();
 		}
 	}
 }
@@ -8,7 +8,10 @@
 
 #include "lunar_magic_extractable.h"
 #include "extraction_exception.h"
+#include "level_rom_data.h"
 #include "../not_found_exception.h"
+#include "../file_util.h"
+#include "../path_util.h"
 
 #include "../configuration/configuration.h"
 
@@ -27,6 +30,7 @@ namespace callisto {
 			static constexpr auto MLW_NO_STRIP_BANK_BYTE{ 0xFF };
 
 			const fs::path mwl_file;
+			const fs::path export_path;
 			const int level_number;
 			const bool strip_source_pointers{ true };  // TODO potentially make this configurable?
 
@@ -34,12 +38,6 @@ namespace callisto {
 
 			static unsigned long long bytesToInt(const std::vector<unsigned char>& bytes, unsigned int offset, size_t number);
 
-			static std::pair<bool, uint8_t> determineSkip(const std::vector<unsigned char>& bytes, unsigned int offset);
-
-			static uint8_t getStandardObjectId(const std::vector<unsigned char>& bytes, unsigned int offset);
-			static uint8_t getExtendedObjectNumber(const std::vector<unsigned char>& bytes, unsigned int offset);
-			static uint8_t get27_29Size(const std::vector<unsigned char>& bytes, unsigned int offset);
-
 			static void writeFourBytes(std::vector<unsigned char>& mwl, unsigned int offset, unsigned int bytes);
 			static void writeFiveBytes(std::vector<unsigned char>& mwl, unsigned int offset, unsigned long long bytes);
 
@@ -48,6 +46,12 @@ namespace callisto {
 			void extract() override;
 
 			static void normalize(const fs::path& mwl_path);
+			static void normalize(std::vector<unsigned char>& mwl_bytes, const fs::path& mwl_path);
+
+			// Moves a freshly exported MWL to its final location, normalizing it on the way, the target 
+			// is only written if its contents actually change, returns whether it was written
+			static bool moveExported(const fs::path& exported_path, const fs::path& target_path, bool strip_source_pointers,
+				OutputWriter& output_writer);
 
 			Level(const Configuration& config, const fs::path& mwl_file, int level_number, const fs::path& extracting_rom);
 		};
@@ -0,0 +1,292 @@
+#include "level_rom_data.h"
+
+namespace callisto {
+	namespace extractables {
+		std::optional<size_t> LevelRomData::snesToPc(size_t snes_address, size_t rom_size) {
+			if ((snes_address & 0x8000) == 0) {
+				return {};
+			}
+
+			const auto pc_offset{ ((snes_address & 0x7F0000) >> 1) | (snes_address & 0x7FFF) };
+			if (pc_offset >= rom_size) {
+				return {};
+			}
+
+			return pc_offset;
+		}
+
+		std::optional<size_t> LevelRomData::getRatsProtectedSize(const std::vector<unsigned char>& rom, size_t pc_offset) {
+			if (pc_offset < RATS_TAG_SIZE || rom[pc_offset - 8] != 'S' || rom[pc_offset - 7] != 'T'
+				|| rom[pc_offset - 6] != 'A' || rom[pc_offset - 5] != 'R') {
+				return {};
+			}
+
+			const auto size{ static_cast<size_t>(rom[pc_offset - 4] | (rom[pc_offset - 3] << 8)) };
+			const auto complement{ static_cast<size_t>(rom[pc_offset - 2] | (rom[pc_offset - 1] << 8)) };
+			if ((size ^ 0xFFFF) != complement) {
+				return {};
+			}
+
+			return size + 1;
+		}
+
+		std::optional<size_t> LevelRomData::getObjectDataSize(const std::vector<unsigned char>& rom, size_t pc_offset) {
+			try {
+				auto curr_offset{ pc_offset + LEVEL_HEADER_SIZE };
+				while (rom.at(curr_offset) != DATA_END_MARKER) {
+					curr_offset += determineSkip(rom, curr_offset).second;
+				}
+				return curr_offset + 1 - pc_offset;
+			}
+			catch (const std::out_of_range&) {
+				return {};
+			}
+		}
+
+		std::optional<size_t> LevelRomData::getSpriteDataSize(const std::vector<unsigned char>& rom, size_t pc_offset) {
+			auto curr_offset{ pc_offset + SPRITE_HEADER_SIZE };
+			while (curr_offset < rom.size() && rom[curr_offset] != DATA_END_MARKER) {
+				curr_offset += SPRITE_ENTRY_SIZE;
+			}
+
+			if (curr_offset >= rom.size()) {
+				return {};
+			}
+
+			return curr_offset + 1 - pc_offset;
+		}
+
+		std::optional<size_t> LevelRomData::getDataSize(const std::vector<unsigned char>& rom, size_t pc_offset, bool is_sprite_data) {
+			// data Lunar Magic moved is RATS protected, which tells us its size directly,
+			// anything else we have to walk to its end marker
+			auto size{ getRatsProtectedSize(rom, pc_offset) };
+			if (!size.has_value()) {
+				size = is_sprite_data ? getSpriteDataSize(rom, pc_offset) : getObjectDataSize(rom, pc_offset);
+			}
+
+			if (!size.has_value() || pc_offset + size.value() > rom.size()) {
+				return {};
+			}
+
+			return size;
+		}
+
+		size_t LevelRomData::readPointer(const std::vector<unsigned char>& rom, size_t pc_offset, size_t size) {
+			size_t pointer{ 0 };
+			for (size_t i{ 0 }; i != size; ++i) {
+				pointer |= static_cast<size_t>(rom.at(pc_offset + i)) << (8 * i);
+			}
+			return pointer;
+		}
+
+		size_t LevelRomData::getSpriteDataPointer(const std::vector<unsigned char>& rom, int level_number) {
+			auto sprite_bank{ rom.at(SPRITE_BANK_TABLE_OFFSET + level_number) };
+			if (sprite_bank == 0x00 || sprite_bank == 0xFF) {
+				sprite_bank = SPRITE_DATA_BANK;
+			}
+			return (sprite_bank << 16) | readPointer(rom, SPRITE_POINTERS_OFFSET + level_number * SPRITE_POINTER_SIZE, SPRITE_POINTER_SIZE);
+		}
+
+		std::pair<bool, uint8_t> LevelRomData::determineSkip(const std::vector<unsigned char>& bytes, size_t offset) {
+			const auto standard_id{ getStandardObjectId(bytes, offset) };
+
+			if (standard_id == 0x0) {
+				const auto extended_no{ getExtendedObjectNumber(bytes, offset) };
+				if (extended_no == 0x0) {
+					// screen exit
+					return { true, 4 };
+				}
+				if (extended_no == 0x2) {
+					// extended screen exit
+					return { true, 5 };
+				}
+				// normal extended object
+				return { false, 3 };
+			}
+			if (standard_id == 0x22 || standard_id == 0x23) {
+				return { false, 4 };
+			}
+			if (standard_id == 0x24 || standard_id == 0x25) {
+				return { false, 3 };
+			}
+			if (standard_id == 0x26) {
+				return { false, 3 };
+			}
+			if (standard_id == 0x27 || standard_id == 0x29) {
+				return { false, get27_29Size(bytes, offset) };
+			}
+			if (standard_id == 0x28) {
+				return { false, 3 } ;
+			}
+			if (standard_id == 0x2D) {
+				return { false, 5 };
+			}
+			return { false, 3 };
+		}
+
+		uint8_t LevelRomData::getStandardObjectId(const std::vector<unsigned char>& bytes, size_t offset) {
+			const auto two{ (bytes.at(offset) << 8) | bytes.at(offset + 1) };
+			const auto high{ (two & 0x6000) >> 9 };
+			const auto low{ (two & 0x00F0) >> 4 };
+			return high | low;
+		}
+
+		uint8_t LevelRomData::getExtendedObjectNumber(const std::vector<unsigned char>& bytes, size_t offset) {
+			return bytes.at(offset + 2);
+		}
+
+		uint8_t LevelRomData::get27_29Size(const std::vector<unsigned char>& bytes, size_t offset) {
+			const auto rel_byte_1{ bytes.at(offset + 3) };
+			const auto masked{ (rel_byte_1 & 0b11000000) >> 6 };
+			if (masked != 0b11) {
+				if (masked == 0b00) {
+					return 5;
+				}
+				else if (masked == 0b01) {
+					return 5;
+				}
+				else {
+					return 6;
+				}
+			}
+			else {
+				const auto rel_byte_2{ bytes.at(offset + 2) };
+				const auto masked_2{ (rel_byte_2 & 0b10000000) >> 7 };
+				if (masked_2 == 0b0) {
+					return 7;
+				}
+				else {
+					return 8;
+				}
+			}
+		}
+
+		std::optional<std::vector<LevelRomData::DataBlock>> LevelRomData::getDataBlocks(const std::vector<unsigned char>& rom, int level_number) {
+			// the sprite bank table is the last table we read from, if the ROM holds that it holds all of them
+			if (static_cast<size_t>(SPRITE_BANK_TABLE_OFFSET + level_number) >= rom.size()) {
+				return {};
+			}
+
+			std::vector<DataBlock> blocks{};
+			const auto add_block{ [&](size_t snes_address, bool is_sprite_data) {
+				const auto pc_offset{ snesToPc(snes_address, rom.size()) };
+				if (!pc_offset.has_value()) {
+					return false;
+				}
+
+				const auto size{ getDataSize(rom, pc_offset.value(), is_sprite_data) };
+				if (!size.has_value()) {
+					return false;
+				}
+
+				blocks.emplace_back(pc_offset.value(), size.value());
+				return true;
+			} };
+
+			if (!add_block(readPointer(rom, LAYER_1_POINTERS_OFFSET + level_number * LAYER_1_POINTER_SIZE, LAYER_1_POINTER_SIZE), false)) {
+				return {};
+			}
+
+			const auto layer_2_pointer{ readPointer(rom, LAYER_2_POINTERS_OFFSET + level_number * LAYER_2_POINTER_SIZE, LAYER_2_POINTER_SIZE) };
+			// backgrounds are shared between levels, so they aren't part of any one level's data
+			if ((layer_2_pointer >> 16) != BACKGROUND_BANK && !add_block(layer_2_pointer, false)) {
+				return {};
+			}
+
+			if (!add_block(getSpriteDataPointer(rom, level_number), true)) {
+				return {};
+			}
+
+			return blocks;
+		}
+
+		std::vector<int> LevelRomData::getModifiedLevelNumbers(const std::vector<unsigned char>& rom) {
+			std::vector<int> level_numbers{};
+			if (LAYER_1_POINTERS_OFFSET + LAYER_1_POINTERS_AMOUNT * LAYER_1_POINTER_SIZE > rom.size()) {
+				return level_numbers;
+			}
+
+			for (int level_number{ 0 }; level_number != LAYER_1_POINTERS_AMOUNT; ++level_number) {
+				if (readPointer(rom, LAYER_1_POINTERS_OFFSET + level_number * LAYER_1_POINTER_SIZE, LAYER_1_POINTER_SIZE) >= MODIFIED_LEVEL_POINTER) {
+					level_numbers.push_back(level_number);
+				}
+			}
+
+			return level_numbers;
+		}
+
+		std::optional<std::string> LevelRomData::fingerprintLevel(const std::vector<unsigned char>& rom, int level_number) {
+			const auto blocks{ getDataBlocks(rom, level_number) };
+			if (!blocks.has_value()) {
+				return {};
+			}
+
+			std::string buffer{};
+			const auto append_bytes{ [&](size_t offset, size_t size) {
+				buffer.append(reinterpret_cast<const char*>(rom.data() + offset), size);
+			} };
+
+			append_bytes(LAYER_1_POINTERS_OFFSET + level_number * LAYER_1_POINTER_SIZE, LAYER_1_POINTER_SIZE);
+			append_bytes(LAYER_2_POINTERS_OFFSET + level_number * LAYER_2_POINTER_SIZE, LAYER_2_POINTER_SIZE);
+			append_bytes(SPRITE_POINTERS_OFFSET + level_number * SPRITE_POINTER_SIZE, SPRITE_POINTER_SIZE);
+			append_bytes(SPRITE_BANK_TABLE_OFFSET + level_number, 1);
+			for (size_t table{ 0 }; table != SECONDARY_HEADER_TABLES_AMOUNT; ++table) {
+				append_bytes(SECONDARY_HEADER_TABLES_OFFSET + table * LAYER_1_POINTERS_AMOUNT + level_number, 1);
+			}
+
+			for (const auto& [pc_offset, size] : blocks.value()) {
+				append_bytes(pc_offset, size);
+			}
+
+			return HashUtil::hashString(buffer);
+		}
+
+		std::string LevelRomData::fingerprintRemainingRom(const std::vector<unsigned char>& rom, const std::vector<int>& level_numbers) {
+			// the pointer tables change whenever a level moves and are covered by the level fingerprints,
+			// the comment and checksum change on every save regardless of what was edited
+			std::vector<std::pair<size_t, size_t>> excluded{
+				{ ROM_CHECKSUM_OFFSET, ROM_CHECKSUM_SIZE },
+				{ LAYER_1_POINTERS_OFFSET, SECONDARY_HEADER_TABLES_OFFSET + SECONDARY_HEADER_TABLES_AMOUNT * LAYER_1_POINTERS_AMOUNT
+					- LAYER_1_POINTERS_OFFSET },
+				{ SPRITE_BANK_TABLE_OFFSET, LAYER_1_POINTERS_AMOUNT },
+				{ ROM_COMMENT_OFFSET, ROM_COMMENT_SIZE }
+			};
+
+			// anything else, including data in the expanded part of the ROM like palettes, ExAnimation and Map16,
+			// isn't covered by any level fingerprint and must go in here
+			for (const auto level_number : level_numbers) {
+				const auto blocks{ getDataBlocks(rom, level_number) };
+				if (!blocks.has_value()) {
+					continue;
+				}
+
+				for (const auto& [pc_offset, size] : blocks.value()) {
+					// Lunar Magic rewrites the tag along with the data
+					if (getRatsProtectedSize(rom, pc_offset).has_value()) {
+						excluded.emplace_back(pc_offset - RATS_TAG_SIZE, size + RATS_TAG_SIZE);
+					}
+					else {
+						excluded.emplace_back(pc_offset, size);
+					}
+				}
+			}
+
+			std::sort(excluded.begin(), excluded.end());
+
+			HashUtil::Hasher hasher{};
+			size_t curr_offset{ 0 };
+			for (const auto& [excluded_start, excluded_size] : excluded) {
+				if (excluded_start >= rom.size()) {
+					break;
+				}
+				if (excluded_start > curr_offset) {
+					hasher.update(reinterpret_cast<const char*>(rom.data() + curr_offset), excluded_start - curr_offset);
+				}
+				curr_offset = std::max(curr_offset, std::min(excluded_start + excluded_size, rom.size()));
+			}
+			hasher.update(reinterpret_cast<const char*>(rom.data() + curr_offset), rom.size() - curr_offset);
+
+			return HashUtil::toHexString(hasher.digest());
+		}
+	}
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../hash_util.h"
+
+namespace callisto {
+	namespace extractables {
+		// Knows where level data lives in an (unheadered) ROM, so we can tell which parts of the ROM
+		// belong to which level without asking Lunar Magic
+		class LevelRomData {
+		public:
+			static constexpr auto LAYER_1_POINTERS_OFFSET{ 0x2E000 };
+			static constexpr auto LAYER_1_POINTER_SIZE{ 3 };
+			static constexpr auto LAYER_1_POINTERS_AMOUNT{ 0x200 };
+			static constexpr auto LAYER_2_POINTERS_OFFSET{ LAYER_1_POINTERS_OFFSET + 0x600 };
+			static constexpr auto LAYER_2_POINTER_SIZE{ 3 };
+			static constexpr auto SPRITE_POINTERS_OFFSET{ 0x2EC00 };
+			static constexpr auto SPRITE_POINTER_SIZE{ 2 };
+			static constexpr auto SPRITE_DATA_BANK{ 0x07 };
+			// Lunar Magic keeps sprite data bank bytes here once it has moved sprite data out of bank $07
+			static constexpr auto SPRITE_BANK_TABLE_OFFSET{ 0x77100 };
+			static constexpr auto SECONDARY_HEADER_TABLES_OFFSET{ 0x2F000 };
+			static constexpr auto SECONDARY_HEADER_TABLES_AMOUNT{ 4 };
+			static constexpr auto BACKGROUND_BANK{ 0xFF };
+			static constexpr auto LEVEL_HEADER_SIZE{ 5 };
+			static constexpr auto SPRITE_HEADER_SIZE{ 1 };
+			static constexpr auto SPRITE_ENTRY_SIZE{ 3 };
+			static constexpr auto DATA_END_MARKER{ 0xFF };
+			static constexpr auto RATS_TAG_SIZE{ 8 };
+			// layer 1 data Lunar Magic saved somewhere past the original ROM
+			static constexpr auto MODIFIED_LEVEL_POINTER{ 0x108000 };
+
+			static constexpr auto ROM_COMMENT_OFFSET{ 0x7F0B8 };
+			static constexpr auto ROM_COMMENT_SIZE{ 0x88 };
+			static constexpr auto ROM_CHECKSUM_OFFSET{ 0x7FDC };
+			static constexpr auto ROM_CHECKSUM_SIZE{ 4 };
+
+			// (pc offset, size) of a piece of level data, not including its RATS tag
+			using DataBlock = std::pair<size_t, size_t>;
+
+			static std::optional<size_t> snesToPc(size_t snes_address, size_t rom_size);
+			static std::optional<size_t> getRatsProtectedSize(const std::vector<unsigned char>& rom, size_t pc_offset);
+			static std::optional<size_t> getObjectDataSize(const std::vector<unsigned char>& rom, size_t pc_offset);
+			static std::optional<size_t> getSpriteDataSize(const std::vector<unsigned char>& rom, size_t pc_offset);
+			static std::optional<size_t> getDataSize(const std::vector<unsigned char>& rom, size_t pc_offset, bool is_sprite_data);
+			static size_t readPointer(const std::vector<unsigned char>& rom, size_t pc_offset, size_t size);
+			static size_t getSpriteDataPointer(const std::vector<unsigned char>& rom, int level_number);
+
+			// first is whether the object is a screen exit, second is how many bytes it takes up
+			static std::pair<bool, uint8_t> determineSkip(const std::vector<unsigned char>& bytes, size_t offset);
+
+			// Returns the layer 1, layer 2 (unless it's a background) and sprite data of the level,
+			// or nothing if any of it can't be found
+			static std::optional<std::vector<DataBlock>> getDataBlocks(const std::vector<unsigned char>& rom, int level_number);
+
+			// Returns the levels whose data Lunar Magic has moved out of the original ROM, i.e. the ones it will export
+			static std::vector<int> getModifiedLevelNumbers(const std::vector<unsigned char>& rom);
+
+			// Hash of the level's pointers, secondary header bytes and data, empty if its data can't be found
+			static std::optional<std::string> fingerprintLevel(const std::vector<unsigned char>& rom, int level_number);
+
+			// Hash of everything in the ROM except the given levels' data, the level pointer and header tables
+			// and the parts Lunar Magic rewrites on every save, if this changes, something other than those
+			// levels was edited and we can't tell which levels it affects
+			static std::string fingerprintRemainingRom(const std::vector<unsigned char>& rom, const std::vector<int>& level_numbers);
+
+		protected:
+			static uint8_t getStandardObjectId(const std::vector<unsigned char>& bytes, size_t offset);
+			static uint8_t getExtendedObjectNumber(const std::vector<unsigned char>& bytes, size_t offset);
+			static uint8_t get27_29Size(const std::vector<unsigned char>& bytes, size_t offset);
+		};
+	}
+}
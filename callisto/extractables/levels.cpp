@@ -3,9 +3,11 @@
 namespace callisto {
 	namespace extractables {
 		Levels::Levels(const Configuration& config, const fs::path& extracting_rom, size_t max_thread_count)
-			: LunarMagicExtractable(config, extracting_rom), levels_folder(config.levels.getOrThrow()), 
+			: LunarMagicExtractable(config, extracting_rom), config(config), levels_folder(config.levels.getOrThrow()), 
 			temp_folder(config.temporary_folder.getOrThrow() / "chunked_roms"), max_thread_count(max_thread_count), 
-			multithread_export(config.enable_multithreaded_level_export.getOrDefault(false)) {
+			level_hashes_path(PathUtil::getLevelHashesPath(config.project_root.getOrThrow())),
+			multithread_export(config.enable_multithreaded_level_export.getOrDefault(false)),
+			incremental_export(config.incremental_level_export.getOrDefault(true)) {
 
 			fs::create_directories(temp_folder);
 
@@ -20,28 +22,35 @@ namespace callisto {
 			}
 		}
 
-		void Levels::normalize() const {
-			spdlog::debug("Stripping source pointers from MWLs in directory {}", levels_folder.string());
-			std::vector<fs::path> mwls{};
-			for (const auto& entry : fs::directory_iterator(levels_folder)) {
+		void Levels::moveExportedLevels(const fs::path& temporary_levels_folder) {
+			spdlog::debug("Moving exported levels from {} to {}", temporary_levels_folder.string(), levels_folder.string());
+
+			std::vector<fs::path> exported{};
+			std::unordered_set<fs::path> exported_names{};
+			for (const auto& entry : fs::directory_iterator(temporary_levels_folder)) {
 				if (entry.path().extension() == ".mwl") {
-					mwls.push_back(entry.path());
+					exported.push_back(entry.path());
+					exported_names.insert(entry.path().filename());
 				}
 			}
 
-			std::exception_ptr thread_exception{};
-			std::for_each(std::execution::par, mwls.begin(), mwls.end(), [&](auto&& path) { 
-				try {
-					Level::normalize(path); 
-				}
-				catch (...) {
-					thread_exception = std::current_exception();
+			std::atomic<size_t> written_count{ 0 };
+			Scheduler::forEach(exported, [&](const auto& path) {
+				if (Level::moveExported(path, levels_folder / path.filename(), strip_source_pointers, output_writer)) {
+					++written_count;
 				}
 			});
 
-			if (thread_exception != nullptr) {
-				std::rethrow_exception(thread_exception);
+			// anything we didn't just export is a level that no longer exists in the ROM
+			for (const auto& entry : fs::directory_iterator(levels_folder)) {
+				if (!exported_names.contains(entry.path().filename())) {
+					output_writer.remove(entry.path());
+				}
 			}
+
+			fs::remove_all(temporary_levels_folder);
+
+			spdlog::debug("{} of {} exported MWL files changed", written_count.load(), exported.size());
 		}
 
 		std::vector<size_t> Levels::determineModifiedOffsets(const fs::path& extracting_rom) {
@@ -49,22 +58,22 @@ namespace callisto {
 			const auto header_size{ rom_size & 0x7FFF };
 
 			std::ifstream rom_file(extracting_rom, std::ios::in | std::ios::binary);
-			rom_file.seekg(header_size + LAYER_1_POINTERS_OFFSET);
+			rom_file.seekg(header_size + LevelRomData::LAYER_1_POINTERS_OFFSET);
 
 			std::vector<size_t> modified_offsets{};
-			auto curr_position{ header_size + LAYER_1_POINTERS_OFFSET };
-			for (auto i{ 0 }; i != LAYER_1_POINTERS_AMOUNT; ++i) {
-				char pointer[LAYER_1_POINTER_SIZE];
-				rom_file.read(pointer, LAYER_1_POINTER_SIZE);
+			auto curr_position{ header_size + LevelRomData::LAYER_1_POINTERS_OFFSET };
+			for (auto i{ 0 }; i != LevelRomData::LAYER_1_POINTERS_AMOUNT; ++i) {
+				char pointer[LevelRomData::LAYER_1_POINTER_SIZE];
+				rom_file.read(pointer, LevelRomData::LAYER_1_POINTER_SIZE);
 
 				uint32_t pointer_val{ static_cast<uint32_t>(static_cast<uint8_t>(pointer[0])) |
 					(static_cast<uint32_t>(static_cast<uint8_t>(pointer[1])) << 8) | (static_cast<uint32_t>(static_cast<uint8_t>(pointer[2])) << 16) };
 
-				if (pointer_val >= 0x108000) {
+				if (pointer_val >= LevelRomData::MODIFIED_LEVEL_POINTER) {
 					modified_offsets.push_back(curr_position);
 				}
 
-				curr_position += LAYER_1_POINTER_SIZE;
+				curr_position += LevelRomData::LAYER_1_POINTER_SIZE;
 			}
 
 			rom_file.close();
@@ -72,37 +81,23 @@ namespace callisto {
 			return modified_offsets;
 		}
 
-		fs::path Levels::createChunkedRom(const fs::path& temp_folder, size_t chunk_idx, size_t levels, size_t skip_start_offset,
+		fs::path Levels::createChunkedRom(const fs::path& temp_folder, size_t chunk_idx, const std::vector<size_t>& kept_offsets,
 			const fs::path& extracting_rom, const std::vector<size_t>& offsets) {
 
 			fs::path temp_rom_path{ (temp_folder / extracting_rom.stem()).string() + '_' 
 				+ std::to_string(chunk_idx) + extracting_rom.extension().string()};
 
-			fs::copy(extracting_rom, temp_rom_path, fs::copy_options::overwrite_existing);
-
-			const auto skip_end_offset{ skip_start_offset + levels };
-			size_t curr_offset{ 0 };
+			// only a handful of pointers differ between chunks, so let the filesystem share the rest if it can
+			FileUtil::cloneFile(extracting_rom, temp_rom_path);
 
 			std::ofstream rom_file(temp_rom_path, std::ios::in | std::ios::out | std::ios::binary);
-			while (true) {
-				if (curr_offset == skip_start_offset) {
-					curr_offset = skip_end_offset;
-				}
-
-				if (curr_offset == offsets.size()) {
-					break;
+			for (const auto modified_offset : offsets) {
+				if (std::binary_search(kept_offsets.begin(), kept_offsets.end(), modified_offset)) {
+					continue;
 				}
 
-				if (curr_offset > offsets.size()) {
-					throw ExtractionException(
-						"Something has gone terribly wrong, please open an issue here: https://github.com/Underrout/callisto/issues/new"
-					);
-				}
-
-				const auto modified_offset{ offsets[curr_offset++] };
-
 				rom_file.seekp(modified_offset);
-				for (size_t i{ 0 }; i != LAYER_1_POINTER_SIZE; ++i) {
+				for (size_t i{ 0 }; i != LevelRomData::LAYER_1_POINTER_SIZE; ++i) {
 					rom_file.put(0x00); // zero out layer 1 data pointer, seems to work fine even though this is of course not a valid pointer
 				}
 				rom_file.seekp(modified_offset + 0x600 + 2);
@@ -113,101 +108,316 @@ namespace callisto {
 			return temp_rom_path;
 		}
 
-		void Levels::extract() {
-			spdlog::info(fmt::format(colors::RESOURCE, "Exporting levels"));
+		std::vector<Levels::WorkItem> Levels::planWorkItems(const std::vector<size_t>& modified_offsets) const {
+			const auto file_bytes{ FileUtil::readAll(extracting_rom) };
+			const auto header_size{ file_bytes.size() & 0x7FFF };
+			const std::vector<unsigned char> rom(file_bytes.begin() + header_size, file_bytes.end());
+
+			std::vector<std::pair<size_t, size_t>> costed_offsets{};
+			size_t total_cost{ 0 };
+			for (const auto modified_offset : modified_offsets) {
+				const auto level_number{ static_cast<int>((modified_offset - header_size - LevelRomData::LAYER_1_POINTERS_OFFSET) / LevelRomData::LAYER_1_POINTER_SIZE) };
+				const auto cost{ estimateExportCost(rom, level_number) };
+				costed_offsets.emplace_back(cost, modified_offset);
+				total_cost += cost;
+			}
 
-			fs::path temporary_levels_folder{ PathUtil::getTemporaryResourcePathFor(temp_folder, "levels") };
-			fs::remove_all(temporary_levels_folder);
-			fs::create_directories(temporary_levels_folder);
+			// biggest levels first, so they get picked up early and the small ones fill in the gaps at the end
+			std::sort(costed_offsets.begin(), costed_offsets.end(), std::greater<>());
+
+			const auto target_cost{ std::max<size_t>(1, total_cost / (max_thread_count * WORK_ITEMS_PER_THREAD)) };
+			std::vector<WorkItem> work_items{};
+			WorkItem current{};
+			for (const auto& [cost, modified_offset] : costed_offsets) {
+				current.offsets.push_back(modified_offset);
+				current.cost += cost;
+				if (current.cost >= target_cost) {
+					work_items.push_back(std::move(current));
+					current = {};
+				}
+			}
+			if (!current.offsets.empty()) {
+				work_items.push_back(std::move(current));
+			}
 
-			spdlog::debug("Exporting levels to temporary folder {} from ROM {}", levels_folder.string(), extracting_rom.string());
+			for (auto& work_item : work_items) {
+				std::sort(work_item.offsets.begin(), work_item.offsets.end());
+			}
 
-			const auto modified_offsets{ determineModifiedOffsets(extracting_rom) };
+			return work_items;
+		}
 
-			if (modified_offsets.size() > max_thread_count && multithread_export) { // would be silly to export in threads when we don't even have that many levels 
-				std::exception_ptr thread_exception{};
-				std::vector<std::jthread> export_threads{};
-				std::vector<int> exit_codes(max_thread_count, 0);
-				std::vector<size_t> level_counts(max_thread_count, modified_offsets.size() / max_thread_count);
-				
-				size_t remainder{ modified_offsets.size() % max_thread_count };
-				for (size_t i{ 0 }; i != remainder; ++i) {
-					++level_counts[i];
-				}
+		size_t Levels::estimateExportCost(const std::vector<unsigned char>& rom, int level_number) {
+			// exporting a level costs a bit no matter how small it is, on top of that it scales with the size of its data
+			size_t cost{ BASE_LEVEL_EXPORT_COST };
+			for (const auto& [pc_offset, size] : LevelRomData::getDataBlocks(rom, level_number).value_or(std::vector<LevelRomData::DataBlock>())) {
+				cost += size;
+			}
+			return cost;
+		}
+
+		Levels::RomFingerprints Levels::fingerprintRom(const fs::path& rom_path, const std::vector<size_t>& modified_offsets) {
+			const auto file_bytes{ FileUtil::readAll(rom_path) };
+			const auto header_size{ file_bytes.size() & 0x7FFF };
+			const std::vector<unsigned char> rom(file_bytes.begin() + header_size, file_bytes.end());
 
-				std::vector<size_t> start_offsets(level_counts.size());
-				start_offsets[0] = 0;
-				std::partial_sum(level_counts.begin(), level_counts.end() - 1, start_offsets.begin() + 1);
+			std::vector<int> level_numbers{};
+			for (const auto modified_offset : modified_offsets) {
+				level_numbers.push_back(static_cast<int>((modified_offset - header_size - LevelRomData::LAYER_1_POINTERS_OFFSET) 
+					/ LevelRomData::LAYER_1_POINTER_SIZE));
+			}
+
+			RomFingerprints fingerprints{ rom.size(), LevelRomData::fingerprintRemainingRom(rom, level_numbers), {} };
+			for (const auto level_number : level_numbers) {
+				// an empty fingerprint never matches, so we'll just always export levels we can't make sense of
+				fingerprints.levels.emplace(level_number, LevelRomData::fingerprintLevel(rom, level_number).value_or(""));
+			}
 
-				for (size_t i{ 0 }; i != max_thread_count; ++i) {
-					export_threads.emplace_back([=, &exit_codes, &modified_offsets, &thread_exception] {
-						try {
-						const auto temp_rom{ createChunkedRom(temp_folder, i,
-							level_counts.at(i), start_offsets.at(i),  extracting_rom, modified_offsets)};
-						const auto exit_code{ callLunarMagic("-ExportMultLevels",
-						temp_rom.string(), (temporary_levels_folder / "level").string()) };
-						exit_codes[i] = exit_code;
-						fs::remove(temp_rom);
-					}
-					catch (...) {
-						thread_exception = std::current_exception();
-					}
-						});
+			return fingerprints;
+		}
+
+		std::optional<int> Levels::getLevelNumber(const fs::path& mwl_path) {
+			const auto stem{ mwl_path.stem().string() };
+			if (mwl_path.extension() != ".mwl" || stem.size() != 9 || !stem.starts_with("level ")) {
+				return {};
+			}
+
+			try {
+				size_t parsed{};
+				const auto level_number{ std::stoi(stem.substr(6), &parsed, 16) };
+				if (parsed != 3 || level_number >= LevelRomData::LAYER_1_POINTERS_AMOUNT) {
+					return {};
 				}
+				return level_number;
+			}
+			catch (...) {
+				return {};
+			}
+		}
 
-				for (auto& thread : export_threads) {
-					thread.join();
+		std::map<int, fs::path> Levels::getMwlPaths() const {
+			std::map<int, fs::path> mwl_paths{};
+			for (const auto& entry : fs::directory_iterator(levels_folder)) {
+				const auto level_number{ getLevelNumber(entry.path()) };
+				if (level_number.has_value()) {
+					mwl_paths.emplace(level_number.value(), entry.path());
 				}
+			}
+			return mwl_paths;
+		}
+
+		std::optional<json> Levels::readLevelHashes() const {
+			if (!fs::exists(level_hashes_path)) {
+				return {};
+			}
+
+			try {
+				std::ifstream file{ level_hashes_path };
+				return json::parse(file);
+			}
+			catch (const json::exception& e) {
+				spdlog::debug("Failed to read level hashes from {}: {}", level_hashes_path.string(), e.what());
+				return {};
+			}
+		}
 
-				if (thread_exception != nullptr) {
-					std::rethrow_exception(thread_exception);
+		void Levels::writeLevelHashes(const RomFingerprints& fingerprints) const {
+			json j;
+			j["rom_size"] = fingerprints.rom_size;
+			j["global"] = fingerprints.global;
+			j["levels"] = json::object();
+
+			const auto mwl_paths{ getMwlPaths() };
+			for (const auto& [level_number, rom_hash] : fingerprints.levels) {
+				const auto mwl_path{ mwl_paths.find(level_number) };
+				if (rom_hash.empty() || mwl_path == mwl_paths.end()) {
+					continue;
 				}
 
-				if (std::all_of(exit_codes.begin(), exit_codes.end(), [](auto e) { return e == 0; })) {
-					spdlog::debug("Copying temporary folder {} to {}", temporary_levels_folder.string(), levels_folder.string());
+				j["levels"][fmt::format("{:03X}", level_number)] = {
+					{ "rom", rom_hash },
+					{ "mwl", HashUtil::hashFile(mwl_path->second) }
+				};
+			}
 
-					fs::remove_all(levels_folder);
-					fs::copy(temporary_levels_folder, levels_folder);
-					fs::remove_all(temporary_levels_folder);
+			fs::create_directories(level_hashes_path.parent_path());
+			std::ofstream file{ level_hashes_path };
+			file << std::setw(4) << j << std::endl;
+		}
 
-					if (strip_source_pointers) {
-						normalize();
-					}
-					spdlog::info("Successfully exported levels!");
+		void Levels::recordExported(const std::vector<int>& level_numbers) const {
+			auto previous{ readLevelHashes() };
+			if (!previous.has_value()) {
+				return;
+			}
+
+			const auto file_bytes{ FileUtil::readAll(extracting_rom) };
+			const auto header_size{ file_bytes.size() & 0x7FFF };
+			const std::vector<unsigned char> rom(file_bytes.begin() + header_size, file_bytes.end());
+
+			// if anything else changed, the next export has to be a full one anyway
+			if (previous.value().value("rom_size", size_t{ 0 }) != rom.size() 
+				|| previous.value().value("global", std::string()) != LevelRomData::fingerprintRemainingRom(rom, LevelRomData::getModifiedLevelNumbers(rom))) {
+				return;
+			}
+
+			const auto mwl_paths{ getMwlPaths() };
+			if (!previous.value().contains("levels")) {
+				previous.value()["levels"] = json::object();
+			}
+			auto& levels{ previous.value()["levels"] };
+			for (const auto level_number : level_numbers) {
+				const auto key{ fmt::format("{:03X}", level_number) };
+				const auto rom_hash{ LevelRomData::fingerprintLevel(rom, level_number) };
+				const auto mwl_path{ mwl_paths.find(level_number) };
+
+				if (!rom_hash.has_value() || mwl_path == mwl_paths.end()) {
+					levels.erase(key);
 				}
 				else {
-					fs::remove_all(temporary_levels_folder);
-					throw ExtractionException(fmt::format(
-						"Failed to export levels from ROM {} to directory {}",
-						extracting_rom.string(), levels_folder.string()
-					));
+					levels[key] = {
+						{ "rom", rom_hash.value() },
+						{ "mwl", HashUtil::hashFile(mwl_path->second) }
+					};
 				}
 			}
-			else {
-				const auto exit_code{ callLunarMagic("-ExportMultLevels",
-					extracting_rom.string(), (temporary_levels_folder / "level").string())};
 
-				if (exit_code == 0) {
-					// TODO merge this with the finalizing code above, literal code duplication, not a good look
-					spdlog::debug("Copying temporary folder {} to {}", temporary_levels_folder.string(), levels_folder.string());
+			std::ofstream file{ level_hashes_path };
+			file << std::setw(4) << previous.value() << std::endl;
+		}
 
-					fs::remove_all(levels_folder);
-					fs::copy(temporary_levels_folder, levels_folder);
-					fs::remove_all(temporary_levels_folder);
+		bool Levels::tryExportChanged(const RomFingerprints& current) {
+			if (!incremental_export) {
+				return false;
+			}
 
-					if (strip_source_pointers) {
-						normalize();
-					}
-					spdlog::info("Successfully exported levels!");
+			const auto previous{ readLevelHashes() };
+			if (!previous.has_value()) {
+				spdlog::debug("No level hashes from a previous export found, exporting all levels");
+				return false;
+			}
+
+			if (previous.value().value("rom_size", size_t{ 0 }) != current.rom_size 
+				|| previous.value().value("global", std::string()) != current.global) {
+				spdlog::debug("ROM changed outside of level data since the previous export, exporting all levels");
+				return false;
+			}
+
+			const auto previous_levels{ previous.value().value("levels", json::object()) };
+			const auto mwl_paths{ getMwlPaths() };
+
+			std::vector<int> changed{};
+			for (const auto& [level_number, rom_hash] : current.levels) {
+				const auto key{ fmt::format("{:03X}", level_number) };
+				const auto mwl_path{ mwl_paths.find(level_number) };
+
+				// the MWL itself must also still be what we exported last time, or we can't trust it
+				if (rom_hash.empty() || mwl_path == mwl_paths.end() || !previous_levels.contains(key)
+					|| previous_levels[key].value("rom", std::string()) != rom_hash
+					|| previous_levels[key].value("mwl", std::string()) != HashUtil::hashFile(mwl_path->second)) {
+					changed.push_back(level_number);
 				}
-				else {
-					fs::remove_all(temporary_levels_folder);
-					throw ExtractionException(fmt::format(
-						"Failed to export levels from ROM {} to directory {}",
-						extracting_rom.string(), levels_folder.string()
-					));
+			}
+
+			if (changed.size() > MAX_SINGLE_LEVEL_EXPORTS) {
+				spdlog::debug("{} levels changed since the previous export, exporting all levels", changed.size());
+				return false;
+			}
+
+			// a full export would drop these as well
+			for (const auto& [level_number, mwl_path] : mwl_paths) {
+				if (!current.levels.contains(level_number)) {
+					spdlog::debug("Level {:03X} is no longer modified in ROM, removing {}", level_number, mwl_path.string());
+					output_writer.remove(mwl_path);
 				}
 			}
+
+			if (changed.empty()) {
+				spdlog::info(fmt::format(colors::PARTIAL_SUCCESS, "No levels changed since the previous export"));
+				return true;
+			}
+
+			spdlog::info(fmt::format(colors::NOTIFICATION, "{} of {} level{} changed since the previous export, only exporting {}",
+				changed.size(), current.levels.size(), current.levels.size() == 1 ? "" : "s", changed.size() == 1 ? "it" : "those"));
+
+			for (const auto level_number : changed) {
+				const auto mwl_path{ mwl_paths.contains(level_number) ? mwl_paths.at(level_number) 
+					: levels_folder / fmt::format("level {:03X}.mwl", level_number) };
+				Level level{ config, mwl_path, level_number, extracting_rom };
+				level.extract();
+				output_writer.recordChanges(level.getChangedFileCount());
+			}
+
+			return true;
+		}
+
+		void Levels::extract() {
+			spdlog::info(fmt::format(colors::RESOURCE, "Exporting levels"));
+
+			const auto modified_offsets{ determineModifiedOffsets(extracting_rom) };
+			const auto fingerprints{ fingerprintRom(extracting_rom, modified_offsets) };
+
+			if (tryExportChanged(fingerprints)) {
+				writeLevelHashes(fingerprints);
+				spdlog::info("Successfully exported levels!");
+				return;
+			}
+
+			fs::path temporary_levels_folder{ PathUtil::getTemporaryResourcePathFor(temp_folder, "levels") };
+			fs::remove_all(temporary_levels_folder);
+			fs::create_directories(temporary_levels_folder);
+
+			exportAll(temporary_levels_folder, modified_offsets);
+			writeLevelHashes(fingerprints);
+		}
+
+		void Levels::exportAll(const fs::path& temporary_levels_folder, const std::vector<size_t>& modified_offsets) {
+			spdlog::debug("Exporting levels to temporary folder {} from ROM {}", levels_folder.string(), extracting_rom.string());
+
+			bool succeeded;
+			if (modified_offsets.size() > max_thread_count && multithread_export) { // would be silly to export in threads when we don't even have that many levels 
+				const auto work_items{ planWorkItems(modified_offsets) };
+				spdlog::debug("Split {} levels into {} work items for {} threads", modified_offsets.size(), work_items.size(), max_thread_count);
+
+				std::vector<int> exit_codes(work_items.size(), 0);
+
+				// shares the thread budget with the other extractables, so this speeds up as they finish
+				Scheduler::forEach(work_items.size(), [&](size_t work_item_idx) {
+					const auto& work_item{ work_items[work_item_idx] };
+					const auto chunk_start{ std::chrono::high_resolution_clock::now() };
+
+					const auto temp_rom{ createChunkedRom(temp_folder, work_item_idx,
+						work_item.offsets, extracting_rom, modified_offsets) };
+					exit_codes[work_item_idx] = callLunarMagic("-ExportMultLevels",
+						temp_rom.string(), (temporary_levels_folder / "level").string());
+					fs::remove(temp_rom);
+
+					const auto chunk_end{ std::chrono::high_resolution_clock::now() };
+					spdlog::debug("Exported work item {} ({} level{}, estimated cost {}) in {}ms", work_item_idx,
+						work_item.offsets.size(), work_item.offsets.size() == 1 ? "" : "s", work_item.cost,
+						std::chrono::duration_cast<std::chrono::milliseconds>(chunk_end - chunk_start).count());
+				});
+
+				succeeded = std::all_of(exit_codes.begin(), exit_codes.end(), [](auto e) { return e == 0; });
+			}
+			else {
+				const auto exit_code{ callLunarMagic("-ExportMultLevels",
+					extracting_rom.string(), (temporary_levels_folder / "level").string())};
+
+				succeeded = exit_code == 0;
+			}
+
+			if (succeeded) {
+				moveExportedLevels(temporary_levels_folder);
+				spdlog::info("Successfully exported levels!");
+			}
+			else {
+				fs::remove_all(temporary_levels_folder);
+				throw ExtractionException(fmt::format(
+					"Failed to export levels from ROM {} to directory {}",
+					extracting_rom.string(), levels_folder.string()
+				));
+			}
 		}
 	}
 }
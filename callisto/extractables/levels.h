@@ -3,41 +3,95 @@
 #include <filesystem>
 #include <algorithm>
 #include <execution>
+#include <map>
+#include <optional>
+#include <fstream>
+#include <iomanip>
+#include <atomic>
+#include <unordered_set>
+#include <chrono>
+#include <thread>
 
 #include <fmt/core.h>
 #include <spdlog/spdlog.h>
+#include <nlohmann/json.hpp>
 
 #include "lunar_magic_extractable.h"
 #include "extraction_exception.h"
 #include "../not_found_exception.h"
+#include "../hash_util.h"
+#include "../file_util.h"
+#include "../path_util.h"
+#include "../scheduler.h"
 #include "level.h"
+#include "level_rom_data.h"
 
 namespace fs = std::filesystem;
+using json = nlohmann::json;
 
 namespace callisto {
 	namespace extractables {
 		class Levels : public LunarMagicExtractable {
 		protected:
-			static constexpr auto LAYER_1_POINTERS_OFFSET{ 0x2E000 };
-			static constexpr auto LAYER_1_POINTER_SIZE{ 3 };
-			static constexpr auto LAYER_1_POINTERS_AMOUNT{ 0x200 };
-			
+			// beyond this many changed levels one multi level export beats exporting them one by one
+			static constexpr auto MAX_SINGLE_LEVEL_EXPORTS{ 16 };
+
+			// more work items than threads lets threads that got cheap items pick up more work instead of idling
+			static constexpr auto WORK_ITEMS_PER_THREAD{ 4 };
+			static constexpr auto BASE_LEVEL_EXPORT_COST{ 0x200 };
+
+			struct WorkItem {
+				std::vector<size_t> offsets{};
+				size_t cost{ 0 };
+			};
+
+			struct RomFingerprints {
+				size_t rom_size;
+				std::string global;
+				std::map<int, std::string> levels;
+			};
+
+			const Configuration& config;
 			const fs::path levels_folder;
 			const bool strip_source_pointers{ true };  // TODO potentially make this configurable?
 			const fs::path temp_folder;
 			const size_t max_thread_count;
+			const fs::path level_hashes_path;
 
 			const bool multithread_export;
+			const bool incremental_export;
 
-			void normalize() const;
+			void moveExportedLevels(const fs::path& temporary_levels_folder);
 			
 			std::vector<size_t> determineModifiedOffsets(const fs::path& extracting_rom);
-			fs::path createChunkedRom(const fs::path& temp_folder, size_t chunk_idx, size_t levels, size_t skip_start_offset,
+			// Creates a copy of the ROM in which every modified level except the kept ones is disabled
+			fs::path createChunkedRom(const fs::path& temp_folder, size_t chunk_idx, const std::vector<size_t>& kept_offsets,
 				const fs::path& extracting_rom, const std::vector<size_t>& offsets);
+			std::vector<WorkItem> planWorkItems(const std::vector<size_t>& modified_offsets) const;
+
+			void exportAll(const fs::path& temporary_levels_folder, const std::vector<size_t>& modified_offsets);
+			bool tryExportChanged(const RomFingerprints& current);
+
+			static size_t estimateExportCost(const std::vector<unsigned char>& rom, int level_number);
+			static RomFingerprints fingerprintRom(const fs::path& rom_path, const std::vector<size_t>& modified_offsets);
+
+			static std::optional<int> getLevelNumber(const fs::path& mwl_path);
+			std::map<int, fs::path> getMwlPaths() const;
+			std::optional<json> readLevelHashes() const;
+			void writeLevelHashes(const RomFingerprints& fingerprints) const;
 
 		public:
 			void extract() override;
 
+			// one Lunar Magic call per work item, potentially hundreds of levels
+			size_t getCost() const override {
+				return 20;
+			}
+
+			// Updates the stored fingerprints of levels that were exported on their own, so the next
+			// export doesn't consider them changed, does nothing if there is nothing to update
+			void recordExported(const std::vector<int>& level_numbers) const;
+
 			Levels(const Configuration& config, const fs::path& extracting_rom, size_t max_thread_count);
 		};
 	}
@@ -4,14 +4,13 @@
 
 #include <fmt/core.h>
 #include <spdlog/spdlog.h>
-#include <boost/process/system.hpp>
 
 #include "extractable.h"
 #include "../configuration/configuration.h"
 #include "../not_found_exception.h"
+#include "../subprocess.h"
 
 namespace fs = std::filesystem;
-namespace bp = boost::process;
 
 namespace callisto {
 	class LunarMagicExtractable : public Extractable {
@@ -21,7 +20,7 @@ namespace callisto {
 
 		template<typename... Args>
 		int callLunarMagic(Args... args) const {
-			return bp::system(lunar_magic_executable.string(), args...);
+			return Subprocess::run(lunar_magic_executable, { std::string(args)... }).exit_code;
 		}
 
 	public:
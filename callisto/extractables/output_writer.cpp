@@ -0,0 +1,132 @@
+#include "output_writer.h"
+
+namespace callisto {
+	namespace extractables {
+		bool OutputWriter::write(std::string_view content, const fs::path& target) {
+			if (target.has_parent_path()) {
+				fs::create_directories(target.parent_path());
+			}
+
+			bool written{ false };
+			try {
+				written = FileUtil::writeIfDifferent(content, target);
+			}
+			catch (const fs::filesystem_error& e) {
+				spdlog::warn(fmt::format(colors::WARNING,
+					"Failed to replace '{}', you might have it open in another program. Falling back to overwriting it in place. "
+					"Underlying filesystem error was:\n\r{}",
+					target.string(), e.what()
+				));
+				overwriteInPlace(content, target);
+				written = true;
+			}
+
+			if (written) {
+				++changed_file_count;
+				spdlog::debug("Wrote changed output file {}", target.string());
+			}
+			return written;
+		}
+
+		bool OutputWriter::moveInto(const fs::path& source, const fs::path& target) {
+			const auto bytes{ FileUtil::readAll(source) };
+			if (bytes.empty() && !fs::exists(source)) {
+				throw ExtractionException(fmt::format(
+					colors::EXCEPTION,
+					"Exported file {} not found",
+					source.string()
+				));
+			}
+
+			const auto written{ write(std::string_view(bytes.data(), bytes.size()), target) };
+			fs::remove(source);
+			return written;
+		}
+
+		void OutputWriter::mirrorFolder(const fs::path& source_folder, const fs::path& target_folder) {
+			std::vector<fs::path> relative_paths{};
+			std::unordered_set<std::string> relative_path_strings{};
+			for (const auto& entry : fs::recursive_directory_iterator(source_folder)) {
+				if (entry.is_regular_file()) {
+					const auto relative_path{ fs::relative(entry.path(), source_folder) };
+					relative_paths.push_back(relative_path);
+					relative_path_strings.insert(relative_path.generic_string());
+				}
+			}
+
+			fs::create_directories(target_folder);
+
+			Scheduler::forEach(relative_paths, [&](const auto& relative_path) {
+				moveInto(source_folder / relative_path, target_folder / relative_path);
+			});
+
+			// collect first, removing while iterating invalidates the iterator
+			std::vector<fs::path> stale_files{};
+			std::vector<fs::path> folders{};
+			for (const auto& entry : fs::recursive_directory_iterator(target_folder)) {
+				const auto relative_path{ fs::relative(entry.path(), target_folder) };
+				if (entry.is_directory()) {
+					folders.push_back(entry.path());
+				}
+				else if (!relative_path_strings.contains(relative_path.generic_string())) {
+					stale_files.push_back(entry.path());
+				}
+			}
+
+			for (const auto& stale_file : stale_files) {
+				remove(stale_file);
+			}
+
+			// deepest folders first, so parents that only contained empty folders go away as well
+			std::sort(folders.begin(), folders.end(), [](const auto& lhs, const auto& rhs) {
+				return lhs.native().size() > rhs.native().size();
+			});
+			for (const auto& folder : folders) {
+				if (fs::is_empty(folder)) {
+					fs::remove(folder);
+				}
+			}
+
+			fs::remove_all(source_folder);
+		}
+
+		void OutputWriter::overwriteInPlace(std::string_view content, const fs::path& target) {
+			// programs that lock a file against being replaced (e.g. an open GFX editor on Windows) 
+			// usually still let others write into it
+			std::ofstream out{ target, std::ios::out | std::ios::binary | std::ios::trunc };
+			out.write(content.data(), content.size());
+			out.close();
+			if (!out) {
+				throw ExtractionException(fmt::format(
+					colors::EXCEPTION,
+					"Failed to overwrite '{}' in place, close any program that has it open and try again",
+					target.string()
+				));
+			}
+		}
+
+		void OutputWriter::remove(const fs::path& target) {
+			spdlog::debug("Removing output file {} that isn't exported anymore", target.string());
+			try {
+				if (fs::remove_all(target) != 0) {
+					++changed_file_count;
+				}
+			}
+			catch (const fs::filesystem_error& e) {
+				spdlog::warn(fmt::format(colors::WARNING,
+					"Failed to remove '{}', which is no longer exported, you might have it open in another program. "
+					"Underlying filesystem error was:\n\r{}",
+					target.string(), e.what()
+				));
+			}
+		}
+
+		void OutputWriter::recordChanges(size_t changed_files) {
+			changed_file_count += changed_files;
+		}
+
+		size_t OutputWriter::getChangedFileCount() const {
+			return changed_file_count;
+		}
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <filesystem>
+#include <algorithm>
+#include <execution>
+#include <fstream>
+#include <atomic>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include "extraction_exception.h"
+#include "../file_util.h"
+#include "../colors.h"
+#include "../scheduler.h"
+
+namespace fs = std::filesystem;
+
+namespace callisto {
+	namespace extractables {
+		// Single place extractables hand their output files to, files are only replaced if their content 
+		// actually changed, so unchanged resources keep their last write time and don't show up as modified
+		class OutputWriter {
+		protected:
+			std::atomic<size_t> changed_file_count{ 0 };
+
+			// Fallback for when target can't be replaced through a rename
+			static void overwriteInPlace(std::string_view content, const fs::path& target);
+
+		public:
+			// Returns whether the file at target was written
+			bool write(std::string_view content, const fs::path& target);
+
+			// Moves a file produced somewhere else (e.g. by Lunar Magic) into place, the source file is removed either way
+			bool moveInto(const fs::path& source, const fs::path& target);
+
+			// Makes target_folder contain exactly the files in source_folder, removing any files that aren't
+			// in source_folder anymore, source_folder is removed afterwards
+			void mirrorFolder(const fs::path& source_folder, const fs::path& target_folder);
+
+			// Removes an output file that is no longer produced
+			void remove(const fs::path& target);
+
+			// For changes made through another writer, e.g. by extractables that run other extractables
+			void recordChanges(size_t changed_files);
+
+			size_t getChangedFileCount() const;
+		};
+	}
+}
@@ -4,7 +4,9 @@ namespace callisto {
 	namespace extractables {
 		SharedPalettes::SharedPalettes(const Configuration& config, const fs::path& extracting_rom)
 			: LunarMagicExtractable(config, extracting_rom),
-			shared_palettes_path(config.shared_palettes.getOrThrow()) {}
+			shared_palettes_path(config.shared_palettes.getOrThrow()),
+			temporary_shared_palettes_path(PathUtil::getTemporaryResourcePathFor(config.temporary_folder.getOrThrow(),
+				shared_palettes_path.filename())) {}
 
 		void SharedPalettes::extract() {
 			spdlog::info(fmt::format(colors::RESOURCE, "Exporting Shared Palettes"));
@@ -15,9 +17,10 @@ namespace callisto {
 			));
 
 			const auto exit_code{ callLunarMagic("-ExportSharedPalette",
-				extracting_rom.string(), shared_palettes_path.string()) };
+				extracting_rom.string(), temporary_shared_palettes_path.string()) };
 
 			if (exit_code == 0) {
+				output_writer.moveInto(temporary_shared_palettes_path, shared_palettes_path);
 				spdlog::info(fmt::format(colors::PARTIAL_SUCCESS, "Successfully exported Shared Palettes!"));
 				spdlog::debug(fmt::format(
 					"Successfully exported Shared Palette file {} from ROM {}",
@@ -7,6 +7,7 @@
 
 #include "lunar_magic_extractable.h"
 #include "extraction_exception.h"
+#include "../path_util.h"
 
 namespace fs = std::filesystem;
 
@@ -15,6 +16,7 @@ namespace callisto {
 		class SharedPalettes : public LunarMagicExtractable {
 		protected:
 			const fs::path shared_palettes_path;
+			const fs::path temporary_shared_palettes_path;
 
 		public:
 			void extract() override;
@@ -3,7 +3,9 @@
 namespace callisto {
 	namespace extractables {
 		TextMap16::TextMap16(const Configuration& config, const fs::path& extracting_rom)
-			: LunarMagicExtractable(config, extracting_rom), map16_folder_path(config.map16.getOrThrow()) {}
+			: LunarMagicExtractable(config, extracting_rom), map16_folder_path(config.map16.getOrThrow()),
+			temporary_map16_folder_path(PathUtil::getTemporaryResourcePathFor(config.temporary_folder.getOrThrow(), 
+				map16_folder_path.filename())) {}
 
 		fs::path TextMap16::getTemporaryMap16FilePath() const {
 			return extracting_rom.parent_path() / (map16_folder_path.string() + ".map16");
@@ -61,19 +63,18 @@ namespace callisto {
 			);
 
 			exportTemporaryMap16File();
-			const auto current_path{ fs::current_path() };
 
 			try {
-				HumanReadableMap16::from_map16::convert(getTemporaryMap16FilePath(), map16_folder_path);
+				// converting wipes the output folder, so convert somewhere else and only carry over what changed
+				HumanReadableMap16::from_map16::convert(getTemporaryMap16FilePath(), temporary_map16_folder_path);
 			}
 			catch (HumanMap16Exception& e) {
-				fs::current_path(current_path);
 				deleteTemporaryMap16File();
 				throw ExtractionException(fmt::format(colors::EXCEPTION, "Failed to convert map16 folder to file with exception:\n\r{}",
 					e.get_detailed_error_message()));
 			}
 
-			fs::current_path(current_path);
+			output_writer.mirrorFolder(temporary_map16_folder_path, map16_folder_path);
 			spdlog::info(fmt::format(colors::PARTIAL_SUCCESS, "Successfully exported Map16 folder!"));
 
 			deleteTemporaryMap16File();
@@ -9,6 +9,7 @@
 #include "lunar_magic_extractable.h"
 #include "extraction_exception.h"
 #include "../not_found_exception.h"
+#include "../path_util.h"
 
 #include "../human_map16/human_readable_map16.h"
 #include "../human_map16/human_map16_exception.h"
@@ -22,6 +23,7 @@ namespace callisto {
 		class TextMap16 : public LunarMagicExtractable {
 		protected:
 			const fs::path map16_folder_path;
+			const fs::path temporary_map16_folder_path;
 
 			fs::path getTemporaryMap16FilePath() const;
 			void exportTemporaryMap16File() const;
@@ -30,6 +32,11 @@ namespace callisto {
 		public:
 			void extract() override;
 
+			// exports binary Map16 first, then converts it
+			size_t getCost() const override {
+				return 3;
+			}
+
 			TextMap16(const Configuration& config, const fs::path& extracting_rom);
 		};
 	}
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#include <winioctl.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace callisto {
+	class FileUtil {
+	public:
+		// Reads the entire file at the given path into memory, returns an empty vector if the file cannot be opened
+		static std::vector<char> readAll(const fs::path& path) {
+			std::ifstream file{ path, std::ios::in | std::ios::binary };
+			if (!file) {
+				return {};
+			}
+			return std::vector<char>((std::istreambuf_iterator<char>(file)), (std::istreambuf_iterator<char>()));
+		}
+
+		// Returns whether the file at the given path exists and contains exactly the passed bytes,
+		// sizes are compared first so we only read the file if we actually need to
+		static bool hasContent(const fs::path& path, std::string_view content) {
+			std::error_code ec;
+			const auto size{ fs::file_size(path, ec) };
+			if (ec || size != content.size()) {
+				return false;
+			}
+
+			const auto existing{ readAll(path) };
+			return existing.size() == content.size() && std::equal(existing.begin(), existing.end(), content.begin());
+		}
+
+		// Writes the passed content to a sibling file first and then renames it over the given path, 
+		// so nobody reading the file ever sees it half written
+		static void writeAtomically(std::string_view content, const fs::path& path) {
+			auto temporary_path{ path };
+			temporary_path += ".tmp";
+
+			std::ofstream out{ temporary_path, std::ios::out | std::ios::binary };
+			out.write(content.data(), content.size());
+			out.close();
+			if (!out) {
+				std::error_code ec;
+				fs::remove(temporary_path, ec);
+				throw std::runtime_error("Failed to write " + temporary_path.string());
+			}
+
+			try {
+				fs::rename(temporary_path, path);
+			}
+			catch (const fs::filesystem_error&) {
+				std::error_code ec;
+				fs::remove(temporary_path, ec);
+				throw;
+			}
+		}
+
+		// Writes the passed content to the given path unless the file already contains exactly that content,
+		// leaving its last write time untouched in that case, returns whether the file was written
+		static bool writeIfDifferent(std::string_view content, const fs::path& path) {
+			if (hasContent(path, content)) {
+				return false;
+			}
+
+			writeAtomically(content, path);
+			return true;
+		}
+
+		// Copies source to target unless target already has the same content, returns whether a copy was made
+		static bool copyIfDifferent(const fs::path& source, const fs::path& target) {
+			std::error_code ec;
+			const auto source_size{ fs::file_size(source, ec) };
+			if (!ec) {
+				const auto target_size{ fs::file_size(target, ec) };
+				if (!ec && source_size == target_size) {
+					const auto source_bytes{ readAll(source) };
+					if (hasContent(target, std::string_view(source_bytes.data(), source_bytes.size()))) {
+						return false;
+					}
+				}
+			}
+
+			fs::copy_file(source, target, fs::copy_options::overwrite_existing);
+			return true;
+		}
+
+		// Copies source to target, sharing the underlying blocks instead of duplicating them where 
+		// the filesystem supports it, so only blocks written to afterwards actually take up space and time, 
+		// that's reflinks (FICLONE) on Linux and block cloning on ReFS volumes on Windows, 
+		// anywhere else (NTFS included) this is a regular copy, returns whether the blocks were shared
+		static bool cloneFile(const fs::path& source, const fs::path& target) {
+			if (tryCloneBlocks(source, target)) {
+				return true;
+			}
+
+			fs::copy_file(source, target, fs::copy_options::overwrite_existing);
+			return false;
+		}
+
+	private:
+		static bool tryCloneBlocks(const fs::path& source, const fs::path& target) {
+#ifdef __linux__
+			const auto source_fd{ open(source.c_str(), O_RDONLY) };
+			if (source_fd == -1) {
+				return false;
+			}
+
+			const auto target_fd{ open(target.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644) };
+			if (target_fd == -1) {
+				close(source_fd);
+				return false;
+			}
+
+			const auto cloned{ ioctl(target_fd, FICLONE, source_fd) == 0 };
+			close(target_fd);
+			close(source_fd);
+			return cloned;
+#elif defined(_WIN32)
+			const auto source_handle{ CreateFileW(source.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, 
+				OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+			if (source_handle == INVALID_HANDLE_VALUE) {
+				return false;
+			}
+
+			DWORD file_system_flags{ 0 };
+			LARGE_INTEGER source_size{};
+			FSCTL_GET_INTEGRITY_INFORMATION_BUFFER integrity{};
+			DWORD returned{ 0 };
+			const auto can_clone{ GetVolumeInformationByHandleW(source_handle, nullptr, 0, nullptr, nullptr,
+				&file_system_flags, nullptr, 0) && (file_system_flags & FILE_SUPPORTS_BLOCK_REFCOUNTING) != 0
+				&& GetFileSizeEx(source_handle, &source_size)
+				&& DeviceIoControl(source_handle, FSCTL_GET_INTEGRITY_INFORMATION, nullptr, 0, 
+					&integrity, sizeof(integrity), &returned, nullptr) };
+			if (!can_clone) {
+				CloseHandle(source_handle);
+				return false;
+			}
+
+			const auto target_handle{ CreateFileW(target.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr,
+				CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr) };
+			if (target_handle == INVALID_HANDLE_VALUE) {
+				CloseHandle(source_handle);
+				return false;
+			}
+
+			// cloned regions have to start and end on cluster boundaries, so the target is grown to a whole 
+			// number of clusters for the clone and cut back to the real size afterwards, both files also 
+			// need the same integrity stream setting
+			const auto cluster_size{ static_cast<LONGLONG>(integrity.ClusterSizeInBytes) };
+			FSCTL_SET_INTEGRITY_INFORMATION_BUFFER target_integrity{ integrity.ChecksumAlgorithm, 0, integrity.Flags };
+			FILE_END_OF_FILE_INFO end_of_file{};
+			end_of_file.EndOfFile.QuadPart = (source_size.QuadPart + cluster_size - 1) / cluster_size * cluster_size;
+			DUPLICATE_EXTENTS_DATA extents{};
+			extents.FileHandle = source_handle;
+			extents.ByteCount.QuadPart = end_of_file.EndOfFile.QuadPart;
+
+			auto cloned{ cluster_size != 0
+				&& DeviceIoControl(target_handle, FSCTL_SET_INTEGRITY_INFORMATION, &target_integrity, 
+					sizeof(target_integrity), nullptr, 0, &returned, nullptr)
+				&& SetFileInformationByHandle(target_handle, FileEndOfFileInfo, &end_of_file, sizeof(end_of_file))
+				&& DeviceIoControl(target_handle, FSCTL_DUPLICATE_EXTENTS_TO_FILE, &extents, sizeof(extents),
+					nullptr, 0, &returned, nullptr) };
+
+			if (cloned) {
+				end_of_file.EndOfFile = source_size;
+				cloned = SetFileInformationByHandle(target_handle, FileEndOfFileInfo, &end_of_file, sizeof(end_of_file));
+			}
+
+			CloseHandle(target_handle);
+			CloseHandle(source_handle);
+			return cloned;
+#else
+			return false;
+#endif
+		}
+	};
+}
@@ -9,6 +9,8 @@ namespace callisto {
 
 		bool ALLOW_USER_INPUT = true;
 
+		std::optional<std::chrono::seconds> PROCESS_TIMEOUT{};
+
 		void setMaxThreadCount(size_t proposed_thread_count) {
 			MAX_THREAD_COUNT = proposed_thread_count > std::jthread::hardware_concurrency()
 				? std::jthread::hardware_concurrency()
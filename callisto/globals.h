@@ -2,11 +2,15 @@
 
 #include <thread>
 #include <mutex>
+#include <chrono>
+#include <optional>
 
 namespace callisto {
 	namespace globals {
 		extern size_t MAX_THREAD_COUNT;
 		extern bool ALLOW_USER_INPUT;
+		// how long external programs may run before they're stopped, no limit if empty
+		extern std::optional<std::chrono::seconds> PROCESS_TIMEOUT;
 		extern std::mutex cin_lock;
 
 		void setMaxThreadCount(size_t proposed_thread_count);
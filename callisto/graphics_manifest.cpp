@@ -0,0 +1,152 @@
+#include "graphics_manifest.h"
+
+namespace callisto {
+	std::map<std::string, GraphicsManifest::Entry> GraphicsManifest::readManifest(const fs::path& manifest_path) {
+		std::map<std::string, Entry> entries{};
+
+		if (!fs::exists(manifest_path)) {
+			return entries;
+		}
+
+		try {
+			std::ifstream file{ manifest_path };
+			const auto j{ json::parse(file) };
+
+			if (j.value("version", 0) != MANIFEST_VERSION) {
+				return entries;
+			}
+
+			for (const auto& [path, entry] : j["files"].items()) {
+				entries.emplace(path, Entry{
+					entry["size"].get<uintmax_t>(),
+					entry["timestamp"].get<int64_t>(),
+					entry["hash"].get<std::string>()
+				});
+			}
+		}
+		catch (const json::exception& e) {
+			spdlog::debug("Failed to read graphics manifest at {}, starting over: {}", manifest_path.string(), e.what());
+			entries.clear();
+		}
+
+		return entries;
+	}
+
+	void GraphicsManifest::writeManifest(const fs::path& manifest_path, const std::map<std::string, Entry>& entries) {
+		json j;
+		j["version"] = MANIFEST_VERSION;
+		j["files"] = json::object();
+
+		for (const auto& [path, entry] : entries) {
+			j["files"][path] = {
+				{ "size", entry.size },
+				{ "timestamp", entry.last_write_time },
+				{ "hash", entry.hash }
+			};
+		}
+
+		fs::create_directories(manifest_path.parent_path());
+		std::ofstream file{ manifest_path };
+		file << std::setw(4) << j << std::endl;
+	}
+
+	void GraphicsManifest::replaceFolderEntries(std::map<std::string, Entry>& entries, const fs::path& folder,
+		std::map<std::string, Entry>&& folder_entries) {
+		// keep entries of the other graphics folder as they are
+		const auto folder_prefix{ (fs::absolute(folder) / "").string() };
+		std::erase_if(entries, [&](const auto& entry) {
+			return entry.first.starts_with(folder_prefix);
+		});
+		entries.merge(folder_entries);
+	}
+
+	GraphicsManifest::Entry GraphicsManifest::getEntryFor(const fs::directory_entry& dir_entry) {
+		return { dir_entry.file_size(), static_cast<int64_t>(dir_entry.last_write_time().time_since_epoch().count()), {} };
+	}
+
+	GraphicsManifest::Fingerprints GraphicsManifest::getFingerprints(const fs::path& folder, const fs::path& project_root) {
+		const auto manifest_path{ PathUtil::getGraphicsManifestPath(project_root) };
+
+		std::scoped_lock lock(manifest_mutex);
+		auto entries{ readManifest(manifest_path) };
+
+		std::map<std::string, Entry> folder_entries{};
+		std::vector<std::pair<fs::path, Entry>> stale{};
+
+		// size and timestamp come from the directory listing, so this doesn't open any files
+		for (const auto& dir_entry : fs::directory_iterator(folder)) {
+			if (!dir_entry.is_regular_file()) {
+				continue;
+			}
+
+			const auto key{ fs::absolute(dir_entry.path()).string() };
+			const auto current{ getEntryFor(dir_entry) };
+
+			const auto known{ entries.find(key) };
+			if (known != entries.end() && known->second.size == current.size
+				&& known->second.last_write_time == current.last_write_time) {
+				folder_entries.emplace(key, known->second);
+			}
+			else {
+				stale.emplace_back(dir_entry.path(), current);
+			}
+		}
+
+		Scheduler::forEach(stale, [](auto& path_and_entry) {
+			path_and_entry.second.hash = HashUtil::hashFile(path_and_entry.first);
+		});
+
+		for (auto& [path, entry] : stale) {
+			folder_entries.emplace(fs::absolute(path).string(), std::move(entry));
+		}
+
+		spdlog::debug("Hashed {} out of {} files in {}", stale.size(), folder_entries.size(), folder.string());
+
+		Fingerprints fingerprints{};
+		for (const auto& [path, entry] : folder_entries) {
+			fingerprints.emplace(fs::path(path).filename().string(), entry.hash);
+		}
+
+		const auto previous_size{ entries.size() };
+		replaceFolderEntries(entries, folder, std::move(folder_entries));
+
+		if (!stale.empty() || entries.size() != previous_size) {
+			try {
+				writeManifest(manifest_path, entries);
+			}
+			catch (const std::exception& e) {
+				spdlog::debug("Failed to write graphics manifest to {}: {}", manifest_path.string(), e.what());
+			}
+		}
+
+		return fingerprints;
+	}
+
+	void GraphicsManifest::record(const fs::path& folder, const Fingerprints& fingerprints, const fs::path& project_root) {
+		const auto manifest_path{ PathUtil::getGraphicsManifestPath(project_root) };
+
+		std::scoped_lock lock(manifest_mutex);
+		auto entries{ readManifest(manifest_path) };
+
+		std::map<std::string, Entry> folder_entries{};
+		for (const auto& dir_entry : fs::directory_iterator(folder)) {
+			const auto fingerprint{ fingerprints.find(dir_entry.path().filename().string()) };
+			if (!dir_entry.is_regular_file() || fingerprint == fingerprints.end()) {
+				continue;
+			}
+
+			auto entry{ getEntryFor(dir_entry) };
+			entry.hash = fingerprint->second;
+			folder_entries.emplace(fs::absolute(dir_entry.path()).string(), std::move(entry));
+		}
+
+		replaceFolderEntries(entries, folder, std::move(folder_entries));
+
+		try {
+			writeManifest(manifest_path, entries);
+		}
+		catch (const std::exception& e) {
+			spdlog::debug("Failed to write graphics manifest to {}: {}", manifest_path.string(), e.what());
+		}
+	}
+}
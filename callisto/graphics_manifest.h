@@ -0,0 +1,58 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <execution>
+
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include "hash_util.h"
+#include "path_util.h"
+#include "scheduler.h"
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace callisto {
+	// Remembers the hash of every (Ex)GFX file in a graphics folder alongside the file's size and last write time,
+	// so files nobody touched since callisto last wrote or hashed them don't need to be read again
+	class GraphicsManifest {
+	public:
+		// file name -> hash of its contents
+		using Fingerprints = std::map<std::string, std::string>;
+
+	protected:
+		static constexpr auto MANIFEST_VERSION{ 1 };
+
+		struct Entry {
+			uintmax_t size;
+			int64_t last_write_time;
+			std::string hash;
+		};
+
+		// the GFX and ExGFX extractables run in parallel and share the manifest file
+		inline static std::mutex manifest_mutex{};
+
+		static std::map<std::string, Entry> readManifest(const fs::path& manifest_path);
+		static void writeManifest(const fs::path& manifest_path, const std::map<std::string, Entry>& entries);
+		static void replaceFolderEntries(std::map<std::string, Entry>& entries, const fs::path& folder, 
+			std::map<std::string, Entry>&& folder_entries);
+
+		static Entry getEntryFor(const fs::directory_entry& dir_entry);
+
+	public:
+		// Returns the fingerprint of every file in the passed folder, only files that changed since the manifest
+		// last saw them are hashed, in parallel
+		static Fingerprints getFingerprints(const fs::path& folder, const fs::path& project_root);
+
+		// Records the fingerprints of files callisto just wrote to the passed folder, so they won't be hashed again
+		static void record(const fs::path& folder, const Fingerprints& fingerprints, const fs::path& project_root);
+	};
+}
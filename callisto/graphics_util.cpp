@@ -1,7 +1,7 @@
 #include "graphics_util.h"
 
 namespace callisto {
-	void GraphicsUtil::exportResources(const Configuration& config, bool exgfx) {
+	void GraphicsUtil::exportResources(const Configuration& config, bool exgfx, extractables::OutputWriter& output_writer) {
 		const auto temporary_export_rom{ 
 			PathUtil::getTemporaryRomPath(config.temporary_folder.getOrThrow(), config.output_rom.getOrThrow()) };
 
@@ -22,22 +22,64 @@ namespace callisto {
 
 		const auto temporary_exported_folder{ temporary_export_rom.parent_path() / fs::path(exgfx_or_gfx) };
 		const auto final_output_path{ getExportFolderPath(config, exgfx) };
+		const auto new_fingerprints{ determineFingerprints(temporary_exported_folder) };
 
 		if (!fs::exists(final_output_path)) {
-			fs::rename(temporary_exported_folder, final_output_path);
+			writeExported(temporary_exported_folder, new_fingerprints, final_output_path, config.project_root.getOrThrow(), output_writer);
 		}
 		else {
-			fixPotentialExportDiscrepancy(temporary_exported_folder, final_output_path, exgfx, config.allow_user_input);
+			fixPotentialExportDiscrepancy(temporary_exported_folder, new_fingerprints, final_output_path, exgfx, config, output_writer);
 		}
 
 		const auto original_folder_proxy{ config.output_rom.getOrThrow().parent_path() / fs::path(exgfx_or_gfx) };
 		linkOutputRomToProjectGraphics(config, exgfx);
 	}
 
-	void GraphicsUtil::importResources(const Configuration& config, const fs::path& rom_path, bool exgfx) {
+	GraphicsUtil::Fingerprints GraphicsUtil::importResources(const Configuration& config, const fs::path& rom_path, bool exgfx,
+		const std::optional<Fingerprints>& in_rom) {
 		const auto source_path{ getExportFolderPath(config, exgfx) };
 		verifyFilenames(source_path, exgfx);
 
+		const auto fingerprints{ GraphicsManifest::getFingerprints(source_path, config.project_root.getOrThrow()) };
+		const auto exgfx_or_gfx{ exgfx ? "ExGraphics" : "Graphics" };
+
+		if (in_rom.has_value()) {
+			std::vector<std::string> changed{};
+			for (const auto& [file_name, hash] : fingerprints) {
+				const auto previous{ in_rom.value().find(file_name) };
+				if (previous == in_rom.value().end() || previous->second != hash) {
+					changed.push_back(file_name);
+				}
+			}
+
+			// Lunar Magic can't take files out of the ROM again, so if any were deleted let it deal with the whole folder
+			const auto any_removed{ std::any_of(in_rom.value().begin(), in_rom.value().end(), [&](const auto& entry) {
+				return !fingerprints.contains(entry.first);
+			}) };
+
+			if (!any_removed && changed.empty()) {
+				spdlog::debug("{} in ROM {} already match {}, nothing to import", exgfx_or_gfx, rom_path.string(), source_path.string());
+				return fingerprints;
+			}
+
+			if (!any_removed && changed.size() != fingerprints.size()) {
+				spdlog::debug("{} of {} {} files changed, only importing those", changed.size(), fingerprints.size(), exgfx_or_gfx);
+				const auto exit_code{ importStaged(config, rom_path, exgfx, source_path, changed) };
+
+				if (exit_code != 0) {
+					throw InsertionException(fmt::format(
+						colors::EXCEPTION,
+						"Failed to import {} changed {} files from {} into ROM {}",
+						changed.size(),
+						exgfx_or_gfx,
+						source_path.string(),
+						rom_path.string()
+					));
+				}
+				return fingerprints;
+			}
+		}
+
 		const auto import_path{ getLunarMagicFolderPath(rom_path, exgfx) };
 
 		if (!fs::exists(import_path) && import_path != source_path) {
@@ -53,18 +95,139 @@ namespace callisto {
 			throw InsertionException(fmt::format(
 				colors::EXCEPTION,
 				"Failed to import {} from {} into ROM {}",
-				exgfx ? "ExGraphics" : "Graphics",
+				exgfx_or_gfx,
 				source_path.string(),
 				rom_path.string()
 			));
 		}
+
+		return fingerprints;
+	}
+
+	int GraphicsUtil::importStaged(const Configuration& config, const fs::path& rom_path, bool exgfx,
+		const fs::path& source_path, const std::vector<std::string>& file_names) {
+		// Lunar Magic always imports from the folder next to the ROM, which usually links to the whole project folder, 
+		// so we briefly move the ROM next to a folder that only contains the files we want imported
+		const auto staging_folder{ rom_path.parent_path() / (rom_path.stem().string() + STAGING_FOLDER_POSTFIX) };
+		const auto staged_rom_path{ staging_folder / rom_path.filename() };
+		const auto staged_graphics_folder{ staging_folder / getLunarMagicFolderName(exgfx) };
+
+		fs::remove_all(staging_folder);
+		fs::create_directories(staged_graphics_folder);
+		for (const auto& file_name : file_names) {
+			FileUtil::cloneFile(source_path / file_name, staged_graphics_folder / file_name);
+		}
+
+		fs::rename(rom_path, staged_rom_path);
+		int exit_code{ -1 };
+		try {
+			exit_code = callLunarMagic(config, getImportCommand(exgfx), staged_rom_path.string());
+		}
+		catch (...) {
+			fs::rename(staged_rom_path, rom_path);
+			fs::remove_all(staging_folder);
+			throw;
+		}
+		fs::rename(staged_rom_path, rom_path);
+		fs::remove_all(staging_folder);
+
+		return exit_code;
 	}
 
-	void GraphicsUtil::fixPotentialExportDiscrepancy(const fs::path& new_folder, const fs::path& old_folder, bool exgfx, bool allow_user_input) {
+	GraphicsUtil::Fingerprints GraphicsUtil::determineFingerprints(const fs::path& graphics_folder) {
+		std::vector<fs::path> paths{};
+		for (const auto& entry : fs::directory_iterator(graphics_folder)) {
+			if (entry.is_regular_file()) {
+				paths.push_back(entry.path());
+			}
+		}
+
+		std::vector<std::string> hashes(paths.size());
+		Scheduler::forEach(paths.size(), [&](size_t i) {
+			hashes[i] = HashUtil::hashFile(paths[i]);
+		});
+
+		Fingerprints fingerprints{};
+		for (size_t i{ 0 }; i != paths.size(); ++i) {
+			fingerprints.emplace(paths[i].filename().string(), hashes[i]);
+		}
+		return fingerprints;
+	}
+
+	GraphicsUtil::Fingerprints GraphicsUtil::getCleanRomFingerprints(const Configuration& config, bool exgfx) {
+		const auto key{ exgfx ? "ex_graphics" : "graphics" };
+		const auto cache_path{ PathUtil::getCleanRomGraphicsPath(config.project_root.getOrThrow()) };
+		const auto clean_rom_hash{ HashUtil::hashFile(config.clean_rom.getOrThrow()) };
+
+		std::scoped_lock lock(clean_rom_fingerprints_mutex);
+
+		if (fs::exists(cache_path)) {
+			try {
+				std::ifstream cache_file{ cache_path };
+				const auto j{ json::parse(cache_file) };
+				if (j.value("clean_rom", std::string()) == clean_rom_hash && j.contains(key)) {
+					return j[key].get<Fingerprints>();
+				}
+			}
+			catch (const json::exception&) {
+				spdlog::debug("Failed to read cached clean ROM graphics fingerprints from {}, exporting them again", cache_path.string());
+			}
+		}
+
+		return exportCleanRomFingerprints(config, clean_rom_hash)[key];
+	}
+
+	std::map<std::string, GraphicsUtil::Fingerprints> GraphicsUtil::exportCleanRomFingerprints(
+		const Configuration& config, const std::string& clean_rom_hash) {
+		spdlog::debug("Exporting graphics from clean ROM {} to fingerprint them", config.clean_rom.getOrThrow().string());
+
+		const auto export_folder{ PathUtil::getTemporaryResourcePathFor(config.temporary_folder.getOrThrow(), CLEAN_ROM_EXPORT_FOLDER_NAME) };
+		fs::remove_all(export_folder);
+		fs::create_directories(export_folder);
+
+		const auto export_rom{ export_folder / config.clean_rom.getOrThrow().filename() };
+		fs::copy_file(config.clean_rom.getOrThrow(), export_rom, fs::copy_options::overwrite_existing);
+
+		std::map<std::string, Fingerprints> fingerprints{};
+		for (const auto exgfx : { false, true }) {
+			const auto key{ exgfx ? "ex_graphics" : "graphics" };
+			const auto exported_folder{ export_folder / getLunarMagicFolderName(exgfx) };
+
+			if (callLunarMagic(config, getExportCommand(exgfx), export_rom.string()) != 0) {
+				// better to import everything than to skip files we can't prove are already in the ROM
+				spdlog::debug("Failed to export {} from clean ROM", getLunarMagicFolderName(exgfx));
+				fingerprints[key] = {};
+			}
+			else {
+				fingerprints[key] = fs::exists(exported_folder) ? determineFingerprints(exported_folder) : Fingerprints{};
+			}
+		}
+
+		std::error_code ec;
+		fs::remove_all(export_folder, ec);
+
+		const auto cache_path{ PathUtil::getCleanRomGraphicsPath(config.project_root.getOrThrow()) };
+		fs::create_directories(cache_path.parent_path());
+
+		json j{};
+		j["clean_rom"] = clean_rom_hash;
+		for (const auto& [key, value] : fingerprints) {
+			j[key] = value;
+		}
+
+		std::ofstream cache_file{ cache_path };
+		cache_file << std::setw(4) << j << std::endl;
+
+		return fingerprints;
+	}
+
+	void GraphicsUtil::fixPotentialExportDiscrepancy(const fs::path& new_folder, const Fingerprints& new_fingerprints,
+		const fs::path& old_folder, bool exgfx, const Configuration& config, extractables::OutputWriter& output_writer) {
 		verifyFilenames(old_folder, exgfx);
-		if (oldAndNewDiffer(new_folder, old_folder, exgfx)) {
+		const auto& project_root{ config.project_root.getOrThrow() };
+		if (oldAndNewDiffer(new_fingerprints, old_folder, project_root)) {
 			const auto exgfx_or_gfx{ exgfx ? "ExGFX" : "GFX" };
-			if (allow_user_input) {
+			if (config.allow_user_input) {
 				std::lock_guard<std::mutex> lock(globals::cin_lock);
 				PromptUtil::yesNoPrompt(fmt::format(
 					colors::WARNING,
@@ -75,7 +238,7 @@ namespace callisto {
 				), [&] {
 					spdlog::info(fmt::format(colors::NOTIFICATION, "Overwriting {} at '{}' with {} from ROM",
 					exgfx_or_gfx, old_folder.string(), exgfx_or_gfx));
-					moveWithFallback(new_folder, old_folder);
+					writeExported(new_folder, new_fingerprints, old_folder, project_root, output_writer);
 					spdlog::info(fmt::format(colors::PARTIAL_SUCCESS, 
 						"Successfully overwrote {} at '{}' with {} from ROM", exgfx_or_gfx, old_folder.string(), exgfx_or_gfx));
 				});
@@ -89,74 +252,28 @@ namespace callisto {
 			}
 		}
 		else {
-			moveWithFallback(new_folder, old_folder);
+			writeExported(new_folder, new_fingerprints, old_folder, project_root, output_writer);
 		}
 	}
 
-	bool GraphicsUtil::oldAndNewDiffer(const fs::path& new_folder, const fs::path& old_folder, bool exgfx) {
-		std::vector<fs::path> new_files{};
-		for (const auto& entry : fs::directory_iterator(new_folder)) {
-			new_files.push_back(entry.path().filename());
-		}
-		std::sort(new_files.begin(), new_files.end());
-
-		std::vector<fs::path> old_files{};
-		for (const auto& entry : fs::directory_iterator(old_folder)) {
-			old_files.push_back(entry.path().filename());
-		}
-		std::sort(old_files.begin(), old_files.end());
-
-		if (new_files.size() != old_files.size()) {
-			return true;
-		}
-
-		std::vector<fs::path> shared_files{};
-		std::set_intersection(new_files.begin(), new_files.end(), 
-			old_files.begin(), old_files.end(), std::back_inserter(shared_files));
-
-		std::exception_ptr thread_exception{};
-		std::atomic_bool differ{ false };
-		std::for_each(std::execution::par, shared_files.begin(), shared_files.end(), [&](const auto& file_path) {
-			try {
-				if (!differ) {
-					const auto old_file{ old_folder / file_path };
-					const auto new_file{ new_folder / file_path };
-					if (!filesEqual(old_file, new_file)) {
-						differ = true;
-					}
-				}
-			}
-			catch (...) {
-				thread_exception = std::current_exception();
-			}
-		});
-
-		if (thread_exception != nullptr) {
-			try {
-				std::rethrow_exception(thread_exception);
-			}
-			catch (const std::exception& e) {
-				throw CallistoException(fmt::format(
-					colors::EXCEPTION,
-					"Failed to compare graphics exported from ROM with project graphics stored in '{}' with exception:\n\r{}", 
-					old_folder.string(), e.what()
-				));
-			}
-		}
-
-		return differ;
+	void GraphicsUtil::writeExported(const fs::path& new_folder, const Fingerprints& new_fingerprints, const fs::path& old_folder,
+		const fs::path& project_root, extractables::OutputWriter& output_writer) {
+		output_writer.mirrorFolder(new_folder, old_folder);
+		GraphicsManifest::record(old_folder, new_fingerprints, project_root);
 	}
 
-	bool GraphicsUtil::filesEqual(const fs::path& file1, const fs::path& file2) {
-		if (fs::file_size(file1) != fs::file_size(file2)) {
-			return false;
+	bool GraphicsUtil::oldAndNewDiffer(const Fingerprints& new_fingerprints, const fs::path& old_folder, const fs::path& project_root) {
+		try {
+			// only files changed since we last wrote or hashed them are read here, exported files are hashed exactly once
+			return GraphicsManifest::getFingerprints(old_folder, project_root) != new_fingerprints;
+		}
+		catch (const std::exception& e) {
+			throw CallistoException(fmt::format(
+				colors::EXCEPTION,
+				"Failed to compare graphics exported from ROM with project graphics stored in '{}' with exception:\n\r{}", 
+				old_folder.string(), e.what()
+			));
 		}
-
-		std::ifstream stream1(file1, std::ios::binary);
-		std::ifstream stream2(file2, std::ios::binary);
-
-		return std::equal(std::istreambuf_iterator<char>(stream1.rdbuf()), 
-			std::istreambuf_iterator<char>(), std::istreambuf_iterator<char>(stream2.rdbuf()));
 	}
 
 	void GraphicsUtil::verifyFilenames(const fs::path& graphics_folder, bool exgfx) {
@@ -249,20 +366,24 @@ namespace callisto {
 		}
 	}
 
-	void GraphicsUtil::importProjectGraphicsInto(const Configuration& config, const fs::path& rom_path) {
-		importResources(config, rom_path, false);
+	GraphicsUtil::Fingerprints GraphicsUtil::importProjectGraphicsInto(const Configuration& config, const fs::path& rom_path,
+		const std::optional<Fingerprints>& in_rom) {
+		return importResources(config, rom_path, false, in_rom);
 	}
 
-	void GraphicsUtil::importProjectExGraphicsInto(const Configuration& config, const fs::path& rom_path) {
-		importResources(config, rom_path, true);
+	GraphicsUtil::Fingerprints GraphicsUtil::importProjectExGraphicsInto(const Configuration& config, const fs::path& rom_path,
+		const std::optional<Fingerprints>& in_rom) {
+		return importResources(config, rom_path, true, in_rom);
 	}
 
-	void GraphicsUtil::exportProjectGraphicsFrom(const Configuration& config, const fs::path& rom_path, bool keep_symlink) {
-		exportResources(config, false);
+	void GraphicsUtil::exportProjectGraphicsFrom(const Configuration& config, const fs::path& rom_path, 
+		extractables::OutputWriter& output_writer, bool keep_symlink) {
+		exportResources(config, false, output_writer);
 	}
 
-	void GraphicsUtil::exportProjectExGraphicsFrom(const Configuration& config, const fs::path& rom_path, bool keep_symlink) {
-		exportResources(config, true);
+	void GraphicsUtil::exportProjectExGraphicsFrom(const Configuration& config, const fs::path& rom_path, 
+		extractables::OutputWriter& output_writer, bool keep_symlink) {
+		exportResources(config, true, output_writer);
 	}
 
 	void GraphicsUtil::linkOutputRomToProjectGraphics(const Configuration& config, bool exgfx) {
@@ -3,9 +3,13 @@
 #include <filesystem>
 #include <algorithm>
 #include <execution>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <fstream>
+#include <iomanip>
 
 #include <fmt/core.h>
-#include <boost/process.hpp>
 
 #ifdef _WIN32
 #include "junction/libntfslinks/include/Junction.h"
@@ -13,10 +17,18 @@
 #endif
 
 #include <spdlog/spdlog.h>
+#include <nlohmann/json.hpp>
 
 #include "insertion_exception.h"
 #include "extractables/extraction_exception.h"
+#include "extractables/output_writer.h"
 #include "not_found_exception.h"
+#include "hash_util.h"
+#include "file_util.h"
+#include "path_util.h"
+#include "graphics_manifest.h"
+#include "scheduler.h"
+#include "subprocess.h"
 
 #include "configuration/configuration.h"
 
@@ -25,16 +37,25 @@
 #include "colors.h"
 
 namespace fs = std::filesystem;
-namespace bp = boost::process;
+using json = nlohmann::json;
 
 namespace callisto {
 	class GraphicsUtil {
+	public:
+		// (Ex)GFX file name -> hash of its contents
+		using Fingerprints = GraphicsManifest::Fingerprints;
+
 	protected:
 		class VerificationException : public CallistoException {
 		public:
 			using CallistoException::CallistoException;
 		};
 
+		static constexpr auto STAGING_FOLDER_POSTFIX{ "_staging" };
+		static constexpr auto CLEAN_ROM_EXPORT_FOLDER_NAME{ "clean_rom_graphics" };
+
+		inline static std::mutex clean_rom_fingerprints_mutex{};
+
 		static constexpr auto GRAPHICS_FOLDER_NAME{ "Graphics" };
 		static constexpr auto EX_GRAPHICS_FOLDER_NAME{ "ExGraphics" };
 
@@ -44,18 +65,23 @@ namespace callisto {
 		static constexpr auto GRAPHICS_IMPORT_COMMAND{ "-ImportGFX" };
 		static constexpr auto EX_GRAPHICS_IMPORT_COMMAND{ "-ImportExGFX" };
 
-		static void exportResources(const Configuration& config, bool exgfx);
-		static void importResources(const Configuration& config, const fs::path& rom_path, bool exgfx);
+		static void exportResources(const Configuration& config, bool exgfx, extractables::OutputWriter& output_writer);
+		static Fingerprints importResources(const Configuration& config, const fs::path& rom_path, bool exgfx,
+			const std::optional<Fingerprints>& in_rom);
+		static int importStaged(const Configuration& config, const fs::path& rom_path, bool exgfx, 
+			const fs::path& source_path, const std::vector<std::string>& file_names);
+		static std::map<std::string, Fingerprints> exportCleanRomFingerprints(const Configuration& config, const std::string& clean_rom_hash);
 
-		static void fixPotentialExportDiscrepancy(const fs::path& new_folder, const fs::path& old_folder, bool exgfx, bool allow_user_input);
+		static void fixPotentialExportDiscrepancy(const fs::path& new_folder, const Fingerprints& new_fingerprints, 
+			const fs::path& old_folder, bool exgfx, const Configuration& config, extractables::OutputWriter& output_writer);
+		static void writeExported(const fs::path& new_folder, const Fingerprints& new_fingerprints, const fs::path& old_folder,
+			const fs::path& project_root, extractables::OutputWriter& output_writer);
 
-		static bool oldAndNewDiffer(const fs::path& new_folder, const fs::path& old_folder, bool exgfx);
+		static bool oldAndNewDiffer(const Fingerprints& new_fingerprints, const fs::path& old_folder, const fs::path& project_root);
 
 		static void verifyFilenames(const fs::path& graphics_folder, bool exgfx);
 		static void verifyFilename(const fs::path& file_path, bool exgfx);
 
-		static bool filesEqual(const fs::path& file1, const fs::path& file2);
-
 		static inline std::string getImportCommand(bool exgfx) {
 			return exgfx ? EX_GRAPHICS_IMPORT_COMMAND : GRAPHICS_IMPORT_COMMAND;
 		}
@@ -88,36 +114,7 @@ namespace callisto {
 
 		template<typename... Args>
 		static inline int callLunarMagic(const Configuration& config, Args... args) {
-			return bp::system(config.lunar_magic_path.getOrThrow().string(), args...);
-		}
-
-		static void moveWithFallback(const fs::path& source, const fs::path& target) {
-			try {
-				fs::remove_all(target);
-				fs::rename(source, target);
-			}
-			catch (const fs::filesystem_error &e) {
-				spdlog::warn(fmt::format(colors::WARNING,
-					"Failed to move source folder '{}' to target folder '{}' via renaming, "
-					"you might have a file in '{}' open in another program. Falling back to element-wise overwrite. "
-					"Underlying filesystem error was:\n\r{}",
-					source.string(), target.string(), target.string(),
-					e.what()
-				));
-
-				try {
-					for (const auto& entry : fs::directory_iterator(source)) {
-						const auto destination{ fs::path(target) / entry.path().filename().string() };
-						fs::copy_file(entry.path(), destination, fs::copy_options::overwrite_existing);
-					}
-
-					fs::remove_all(source);
-					spdlog::debug("Successfully performed element-wise overwrite.");
-				}
-				catch (const fs::filesystem_error& ie) {
-					throw CallistoException(fmt::format("Failed to perform element-wise overwrite with underlying exception:\n\r{}", ie.what()));
-				}
-			}
+			return Subprocess::run(config.lunar_magic_path.getOrThrow(), { std::string(args)... }).exit_code;
 		}
 
 #ifdef _WIN32
@@ -225,11 +222,22 @@ namespace callisto {
 			return target_rom_path.parent_path() / getLunarMagicFolderName(exgfx);
 		}
 
-		static void importProjectGraphicsInto(const Configuration& config, const fs::path& rom_path);
-		static void importProjectExGraphicsInto(const Configuration& config, const fs::path& rom_path);
+		// If the fingerprints of the (Ex)GFX currently in the ROM are passed, only files that differ from those are imported,
+		// returns the fingerprints of the project's (Ex)GFX, which is what's in the ROM afterwards
+		static Fingerprints importProjectGraphicsInto(const Configuration& config, const fs::path& rom_path, 
+			const std::optional<Fingerprints>& in_rom = std::nullopt);
+		static Fingerprints importProjectExGraphicsInto(const Configuration& config, const fs::path& rom_path,
+			const std::optional<Fingerprints>& in_rom = std::nullopt);
+
+		static Fingerprints determineFingerprints(const fs::path& graphics_folder);
+
+		// Fingerprints of the (Ex)GFX in the clean ROM, these are only exported once per clean ROM and cached after
+		static Fingerprints getCleanRomFingerprints(const Configuration& config, bool exgfx);
 
-		static void exportProjectGraphicsFrom(const Configuration& config, const fs::path& rom_path, bool keep_symlink = true);
-		static void exportProjectExGraphicsFrom(const Configuration& config, const fs::path& rom_path, bool keep_symlink = true);
+		static void exportProjectGraphicsFrom(const Configuration& config, const fs::path& rom_path, 
+			extractables::OutputWriter& output_writer, bool keep_symlink = true);
+		static void exportProjectExGraphicsFrom(const Configuration& config, const fs::path& rom_path, 
+			extractables::OutputWriter& output_writer, bool keep_symlink = true);
 
 		static void linkOutputRomToProjectGraphics(const Configuration& config, bool exgfx);
 	};
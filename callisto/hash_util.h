@@ -0,0 +1,225 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <fstream>
+#include <vector>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include <fmt/format.h>
+
+#include "file_util.h"
+
+namespace fs = std::filesystem;
+
+namespace callisto {
+	class HashUtil {
+	private:
+		static constexpr uint64_t PRIME_1{ 0x9E3779B185EBCA87ULL };
+		static constexpr uint64_t PRIME_2{ 0xC2B2AE3D27D4EB4FULL };
+		static constexpr uint64_t PRIME_3{ 0x165667B19E3779F9ULL };
+		static constexpr uint64_t PRIME_4{ 0x85EBCA77C2B2AE63ULL };
+		static constexpr uint64_t PRIME_5{ 0x27D4EB2F165667C5ULL };
+
+		static constexpr size_t FILE_CHUNK_SIZE{ 1 << 20 };
+
+		static constexpr uint32_t CRC32_POLYNOMIAL{ 0xEDB88320 };
+
+		// table[0] is the usual bytewise CRC32 table, table[n] advances a byte through n more zero bytes,
+		// which lets us process 8 bytes per step instead of 1
+		static constexpr auto CRC32_TABLES{ [] {
+			std::array<std::array<uint32_t, 256>, 8> tables{};
+			for (uint32_t i{ 0 }; i != 256; ++i) {
+				uint32_t crc{ i };
+				for (int bit{ 0 }; bit != 8; ++bit) {
+					crc = (crc >> 1) ^ ((crc & 1) ? CRC32_POLYNOMIAL : 0);
+				}
+				tables[0][i] = crc;
+			}
+			for (size_t table{ 1 }; table != tables.size(); ++table) {
+				for (size_t i{ 0 }; i != 256; ++i) {
+					tables[table][i] = (tables[table - 1][i] >> 8) ^ tables[0][tables[table - 1][i] & 0xFF];
+				}
+			}
+			return tables;
+		}() };
+
+		static constexpr uint64_t rotateLeft(uint64_t value, int amount) {
+			return (value << amount) | (value >> (64 - amount));
+		}
+
+		static uint64_t read64(const unsigned char* bytes) {
+			uint64_t value{ 0 };
+			for (int i{ 7 }; i >= 0; --i) {
+				value = (value << 8) | bytes[i];
+			}
+			return value;
+		}
+
+		static uint64_t read32(const unsigned char* bytes) {
+			return static_cast<uint64_t>(bytes[0]) | (static_cast<uint64_t>(bytes[1]) << 8)
+				| (static_cast<uint64_t>(bytes[2]) << 16) | (static_cast<uint64_t>(bytes[3]) << 24);
+		}
+
+		static constexpr uint64_t round(uint64_t accumulator, uint64_t input) {
+			accumulator += input * PRIME_2;
+			accumulator = rotateLeft(accumulator, 31);
+			return accumulator * PRIME_1;
+		}
+
+		static constexpr uint64_t mergeRound(uint64_t accumulator, uint64_t value) {
+			accumulator ^= round(0, value);
+			return accumulator * PRIME_1 + PRIME_4;
+		}
+
+		static uint64_t finalize(uint64_t hash, const unsigned char* current, const unsigned char* end) {
+			while (current + 8 <= end) {
+				hash ^= round(0, read64(current));
+				hash = rotateLeft(hash, 27) * PRIME_1 + PRIME_4;
+				current += 8;
+			}
+
+			if (current + 4 <= end) {
+				hash ^= read32(current) * PRIME_1;
+				hash = rotateLeft(hash, 23) * PRIME_2 + PRIME_3;
+				current += 4;
+			}
+
+			while (current < end) {
+				hash ^= *current * PRIME_5;
+				hash = rotateLeft(hash, 11) * PRIME_1;
+				++current;
+			}
+
+			hash ^= hash >> 33;
+			hash *= PRIME_2;
+			hash ^= hash >> 29;
+			hash *= PRIME_3;
+			hash ^= hash >> 32;
+
+			return hash;
+		}
+
+		static uint64_t mergeAccumulators(uint64_t v1, uint64_t v2, uint64_t v3, uint64_t v4) {
+			uint64_t hash{ rotateLeft(v1, 1) + rotateLeft(v2, 7) + rotateLeft(v3, 12) + rotateLeft(v4, 18) };
+			hash = mergeRound(hash, v1);
+			hash = mergeRound(hash, v2);
+			hash = mergeRound(hash, v3);
+			return mergeRound(hash, v4);
+		}
+
+	public:
+		// Computes the same XXH64 as xxh64() over everything passed to update(), so large files can be hashed
+		// in chunks instead of being read into memory whole
+		class Hasher {
+		protected:
+			uint64_t v1;
+			uint64_t v2;
+			uint64_t v3;
+			uint64_t v4;
+			const uint64_t seed;
+			uint64_t total_size{ 0 };
+			unsigned char buffer[32]{};
+			size_t buffered{ 0 };
+
+			void consumeStripe(const unsigned char* stripe) {
+				v1 = round(v1, read64(stripe));
+				v2 = round(v2, read64(stripe + 8));
+				v3 = round(v3, read64(stripe + 16));
+				v4 = round(v4, read64(stripe + 24));
+			}
+
+		public:
+			explicit Hasher(uint64_t seed = 0)
+				: v1(seed + PRIME_1 + PRIME_2), v2(seed + PRIME_2), v3(seed), v4(seed - PRIME_1), seed(seed) {}
+
+			void update(const char* data, size_t size) {
+				auto current{ reinterpret_cast<const unsigned char*>(data) };
+				const auto end{ current + size };
+				total_size += size;
+
+				if (buffered != 0) {
+					const auto needed{ std::min(sizeof(buffer) - buffered, size) };
+					std::memcpy(buffer + buffered, current, needed);
+					buffered += needed;
+					current += needed;
+					if (buffered != sizeof(buffer)) {
+						return;
+					}
+					consumeStripe(buffer);
+					buffered = 0;
+				}
+
+				while (end - current >= 32) {
+					consumeStripe(current);
+					current += 32;
+				}
+
+				std::memcpy(buffer, current, end - current);
+				buffered = end - current;
+			}
+
+			uint64_t digest() const {
+				uint64_t hash{ total_size >= 32 ? mergeAccumulators(v1, v2, v3, v4) : seed + PRIME_5 };
+				hash += total_size;
+				return finalize(hash, buffer, buffer + buffered);
+			}
+		};
+
+		// XXH64, fast enough that hashing a file costs about as much as reading it
+		static uint64_t xxh64(const char* data, size_t size, uint64_t seed = 0) {
+			Hasher hasher{ seed };
+			hasher.update(data, size);
+			return hasher.digest();
+		}
+
+		// Standard (zlib/PNG/BPS) CRC32, pass the result of a previous call as crc to continue it with more data
+		static uint32_t crc32(const char* data, size_t size, uint32_t crc = 0) {
+			const auto* current{ reinterpret_cast<const unsigned char*>(data) };
+			const auto* const end{ current + size };
+			crc = ~crc;
+
+			while (end - current >= 8) {
+				const auto low{ static_cast<uint32_t>(read32(current)) ^ crc };
+				const auto high{ static_cast<uint32_t>(read32(current + 4)) };
+				crc = CRC32_TABLES[7][low & 0xFF] ^ CRC32_TABLES[6][(low >> 8) & 0xFF]
+					^ CRC32_TABLES[5][(low >> 16) & 0xFF] ^ CRC32_TABLES[4][low >> 24]
+					^ CRC32_TABLES[3][high & 0xFF] ^ CRC32_TABLES[2][(high >> 8) & 0xFF]
+					^ CRC32_TABLES[1][(high >> 16) & 0xFF] ^ CRC32_TABLES[0][high >> 24];
+				current += 8;
+			}
+
+			while (current != end) {
+				crc = (crc >> 8) ^ CRC32_TABLES[0][(crc ^ *current) & 0xFF];
+				++current;
+			}
+
+			return ~crc;
+		}
+
+		static std::string toHexString(uint64_t hash) {
+			return fmt::format("{:016x}", hash);
+		}
+
+		static std::string hashString(std::string_view content) {
+			return toHexString(xxh64(content.data(), content.size()));
+		}
+
+		// Returns the hash of the file's contents as a hex string, fit for storing in JSON, 
+		// the file is read in large chunks so memory use doesn't grow with its size
+		static std::string hashFile(const fs::path& path) {
+			std::ifstream file{ path, std::ios::in | std::ios::binary };
+			Hasher hasher{};
+			std::vector<char> chunk(FILE_CHUNK_SIZE);
+			while (file) {
+				file.read(chunk.data(), chunk.size());
+				hasher.update(chunk.data(), static_cast<size_t>(file.gcount()));
+			}
+			return toHexString(hasher.digest());
+		}
+	};
+}
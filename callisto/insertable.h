@@ -1,7 +1,9 @@
 #pragma once
 
+#include <optional>
 #include <string>
 #include <unordered_set>
+#include <vector>
 
 #include "dependency/configuration_dependency.h"
 #include "configuration/config_variable.h"
@@ -113,6 +115,12 @@ namespace callisto {
 			return configuration_dependencies;
 		}
 
+		// The paths inserting reads if they're known before inserting, builders use them to tell what may safely 
+		// run alongside the insertion, nothing if they only turn up while inserting, like files a patch includes
+		virtual std::optional<std::vector<fs::path>> getKnownInputPaths() {
+			return {};
+		}
+
 		virtual ~Insertable() {}
 	};
 }
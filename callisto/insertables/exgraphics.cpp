@@ -23,6 +23,14 @@ namespace callisto {
 		return dependencies;
 	}
 
+	void ExGraphics::setPreviousFingerprints(const GraphicsUtil::Fingerprints& previous) {
+		previous_fingerprints = previous;
+	}
+
+	const GraphicsUtil::Fingerprints& ExGraphics::getFingerprints() const {
+		return fingerprints;
+	}
+
 	void ExGraphics::insert() {
 		checkLunarMagicExists();
 
@@ -46,7 +54,7 @@ namespace callisto {
 		));
 
 		try {
-			GraphicsUtil::importProjectExGraphicsInto(config, temporary_rom_path);
+			fingerprints = GraphicsUtil::importProjectExGraphicsInto(config, temporary_rom_path, previous_fingerprints);
 		}
 		catch (const std::exception& e) {
 			throw InsertionException(fmt::format(
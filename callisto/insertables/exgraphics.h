@@ -1,6 +1,7 @@
 #pragma once
 
 #include <filesystem>
+#include <optional>
 
 #include <fmt/core.h>
 
@@ -23,11 +24,18 @@ namespace callisto {
 		const fs::path project_exgraphics_folder_path;
 		const Configuration& config;
 
+		std::optional<GraphicsUtil::Fingerprints> previous_fingerprints{};
+		GraphicsUtil::Fingerprints fingerprints{};
+
 		std::unordered_set<ResourceDependency> determineDependencies() override;
 
 	public:
 		void insert() override;
 
+		// Only files whose fingerprint differs from the passed one will be imported on insertion
+		void setPreviousFingerprints(const GraphicsUtil::Fingerprints& previous);
+		const GraphicsUtil::Fingerprints& getFingerprints() const;
+
 		ExGraphics(const Configuration& config);
 	};
 }
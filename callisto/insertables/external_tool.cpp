@@ -10,7 +10,10 @@ namespace callisto {
 		pass_rom(tool_config.pass_rom.getOrDefault(true)),
 		temporary_rom(PathUtil::getTemporaryRomPath(config.temporary_folder.getOrThrow(), config.output_rom.getOrThrow())),
 		static_dependencies(tool_config.static_dependencies.getOrDefault({})),
-		dependency_report_file_path(tool_config.dependency_report_file.getOrDefault({}))
+		dependency_report_file_path(tool_config.dependency_report_file.getOrDefault({})),
+		// the tool is started in its working directory instead of us changing ours, 
+		// since other tools and insertables may be running alongside it
+		context(ExecutionContext(config).withBaseDirectory(working_directory))
 	{
 		registerConfigurationDependency(tool_config.executable);
 		registerConfigurationDependency(tool_config.options, Policy::REINSERT);
@@ -62,8 +65,32 @@ namespace callisto {
 		fs::remove(local_callisto_file_path);
 	}
 
+	bool ExternalTool::runsAheadOfInsertion() const {
+		return !pass_rom && !take_user_input;
+	}
+
+	const fs::path& ExternalTool::getWorkingDirectory() const {
+		return working_directory;
+	}
+
+	const std::vector<ResourceDependency>& ExternalTool::getStaticDependencies() const {
+		return static_dependencies;
+	}
+
+	void ExternalTool::init() {
+		if (runsAheadOfInsertion()) {
+			run();
+		}
+	}
+
 	void ExternalTool::insert() {
-		if (!fs::exists(temporary_rom)) {
+		if (!runsAheadOfInsertion()) {
+			run();
+		}
+	}
+
+	void ExternalTool::run() {
+		if (pass_rom && !fs::exists(temporary_rom)) {
 			throw RomNotFoundException(fmt::format(
 				colors::EXCEPTION,
 				"Temporary ROM not found at {}",
@@ -102,33 +129,23 @@ namespace callisto {
 			tool_options
 		));
 
-		const auto prev_folder{ fs::current_path() };
-		fs::current_path(working_directory);
 		deleteLocalCallistoFile();
 		createLocalCallistoFile();
 
-		int exit_code;
-		if (take_user_input) {
-			exit_code = bp::system(fmt::format(
-				"\"{}\" {}{}",
-				tool_exe_path.string(),
-				tool_options,
-				pass_rom ? " \"" + temporary_rom.string() + '"' : ""
-			), bp::std_in < stdin, bp::std_out > stdout, bp::std_err > stderr);
-		}
-		else {
-			exit_code = bp::system(fmt::format(
-				"\"{}\" {}{}",
-				tool_exe_path.string(),
-				tool_options,
-				pass_rom ? " \"" + temporary_rom.string() + '"' : ""
-			), bp::std_in < bp::null, bp::std_out > stdout, bp::std_err > stderr);
-		}
+		auto options{ context.subprocessOptions() };
+		options.take_user_input = take_user_input;
+		const auto result{ Subprocess::runCommandLine(fmt::format(
+			"\"{}\" {}{}",
+			tool_exe_path.string(),
+			tool_options,
+			pass_rom ? " \"" + temporary_rom.string() + '"' : ""
+		), options) };
 
 		deleteLocalCallistoFile();
-		fs::current_path(prev_folder);
 
-		if (exit_code == 0) {
+		spdlog::debug("{} took {}ms, {}ms of CPU time", tool_name, result.wall_time.count(), result.cpu_time.count());
+
+		if (result.succeeded()) {
 			spdlog::info(fmt::format(colors::PARTIAL_SUCCESS, "Successfully ran {}!", tool_name));
 		}
 		else {
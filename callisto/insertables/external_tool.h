@@ -2,8 +2,6 @@
 
 #include <filesystem>
 
-#include <boost/process/system.hpp>
-#include <boost/process.hpp>
 #include <fmt/core.h>
 #include <spdlog/spdlog.h>
 
@@ -16,9 +14,9 @@
 #include "../dependency/policy.h"
 #include "../dependency/resource_dependency.h"
 #include "../path_util.h"
+#include "../execution_context.h"
 
 namespace fs = std::filesystem;
-namespace bp = boost::process;
 
 namespace callisto {
 	class ExternalTool : public Insertable {
@@ -33,15 +31,26 @@ namespace callisto {
 		const std::vector<ResourceDependency> static_dependencies;
 		const std::optional<fs::path> dependency_report_file_path;
 		const fs::path callisto_folder_path;
+		const ExecutionContext context;
 
 		std::unordered_set<ResourceDependency> determineDependencies() override;
 
 		void createLocalCallistoFile();
 		void deleteLocalCallistoFile();
 
+		void run();
+
 	public:
 		ExternalTool(const std::string& name, const Configuration& config, const ToolConfiguration& tool_config);
 
+		// Whether this tool neither touches the ROM nor needs the terminal, such tools are run by init()
+		// so builders can run them alongside other insertions and each other, insert() then does nothing
+		bool runsAheadOfInsertion() const;
+
+		const fs::path& getWorkingDirectory() const;
+		const std::vector<ResourceDependency>& getStaticDependencies() const;
+
+		void init() override;
 		void insert() override;
 	};
 }
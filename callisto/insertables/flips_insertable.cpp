@@ -44,8 +44,27 @@ namespace callisto {
 			bps_path.string(),
 			clean_rom_path.string()
 		));
-		int exit_code{ bp::system(flips_path.string(), "--apply", bps_path.string(),
-			clean_rom_path.string(), output_rom_path.string()) };
+
+		try {
+			const auto result{ Bps::applyFile(bps_path, clean_rom_path, output_rom_path) };
+			spdlog::debug(fmt::format("Successfully patched to {}, {} changed range(s)", 
+				output_rom_path.string(), result.changed_ranges.size()));
+			return 0;
+		}
+		catch (const BpsException& e) {
+			spdlog::debug("Failed to apply BPS patch {} directly, falling back to FLIPS: {}", bps_path.string(), e.what());
+		}
+
+		if (!fs::exists(flips_path)) {
+			throw ToolNotFoundException(fmt::format(
+				colors::EXCEPTION,
+				"FLIPS not found at {}",
+				flips_path.string()
+			));
+		}
+
+		const auto exit_code{ Subprocess::run(flips_path, { "--apply", bps_path.string(),
+			clean_rom_path.string(), output_rom_path.string() }).exit_code };
 
 		if (exit_code == 0) {
 			spdlog::debug(fmt::format("Successfully patched to {}", output_rom_path.string()));
@@ -110,16 +129,97 @@ namespace callisto {
 		}
 	}
 
+	std::string FlipsInsertable::determineBaseHash() const {
+		const auto& project_root{ config.project_root.getOrThrow() };
+		std::string base{ HashUtil::hashFile(clean_rom_path) };
+		// keyed by the executable's content like the expanded clean ROM, so upgrading Lunar Magic in place invalidates it
+		base += HashUtil::hashFile(config.lunar_magic_path.getOrThrow());
+
+		for (const auto exgfx : { false, true }) {
+			if ((exgfx && needs_exgfx) || (!exgfx && needs_gfx)) {
+				base += exgfx ? "ExGFX" : "GFX";
+				for (const auto& [file_name, hash] : GraphicsManifest::getFingerprints(GraphicsUtil::getExportFolderPath(config, exgfx), project_root)) {
+					base += file_name + hash;
+				}
+			}
+		}
+
+		return HashUtil::hashString(base);
+	}
+
+	fs::path FlipsInsertable::getCachedPatchedRomPath() const {
+		return PathUtil::getPatchedRomCacheDirectoryPath(config.project_root.getOrThrow()) 
+			/ ("patched" + getTemporaryPatchedRomPostfix() + temporary_rom_path.extension().string());
+	}
+
+	bool FlipsInsertable::tryRestoreCachedPatchedRom(const std::string& bps_hash, const std::string& base_hash) const {
+		const auto cached_rom_path{ getCachedPatchedRomPath() };
+		auto key_path{ cached_rom_path };
+		key_path.replace_extension(".json");
+
+		if (!fs::exists(cached_rom_path) || !fs::exists(key_path)) {
+			return false;
+		}
+
+		try {
+			std::ifstream key_file{ key_path };
+			const auto j{ json::parse(key_file) };
+			if (j.value("bps", std::string()) != bps_hash || j.value("base", std::string()) != base_hash) {
+				return false;
+			}
+		}
+		catch (const json::exception&) {
+			return false;
+		}
+
+		FileUtil::cloneFile(cached_rom_path, temporary_patched_rom_path);
+		return true;
+	}
+
+	void FlipsInsertable::cachePatchedRom(const std::string& bps_hash, const std::string& base_hash) const {
+		const auto cached_rom_path{ getCachedPatchedRomPath() };
+		auto key_path{ cached_rom_path };
+		key_path.replace_extension(".json");
+
+		try {
+			// key is removed first and written last, so an interrupted write never leaves a ROM that looks valid
+			fs::create_directories(cached_rom_path.parent_path());
+			fs::remove(key_path);
+			FileUtil::cloneFile(temporary_patched_rom_path, cached_rom_path);
+
+			std::ofstream key_file{ key_path };
+			key_file << std::setw(4) << json({ { "bps", bps_hash }, { "base", base_hash } }) << std::endl;
+		}
+		catch (const std::exception& e) {
+			spdlog::debug("Failed to cache patched {} ROM at {}: {}", getResourceName(), cached_rom_path.string(), e.what());
+		}
+	}
+
 	void FlipsInsertable::init() {
+		temporary_patched_rom_path = getTemporaryPatchedRomPath();
+
+		const auto bps_hash{ HashUtil::hashFile(bps_patch_path) };
+		const auto base_hash{ determineBaseHash() };
+
+		if (tryRestoreCachedPatchedRom(bps_hash, base_hash)) {
+			spdlog::debug("Reusing cached {} ROM, neither its patch nor its graphics changed", getResourceName());
+			return;
+		}
+
 		temporary_patched_rom_path = createTemporaryPatchedRom();
 
+		// the patched ROM is built from the clean ROM, so files that are the same as in there don't need importing
 		if (needs_gfx) {
-			GraphicsUtil::importProjectGraphicsInto(config, temporary_patched_rom_path);
+			GraphicsUtil::importProjectGraphicsInto(config, temporary_patched_rom_path, 
+				GraphicsUtil::getCleanRomFingerprints(config, false));
 		}
 
 		if (needs_exgfx) {
-			GraphicsUtil::importProjectExGraphicsInto(config, temporary_patched_rom_path);
+			GraphicsUtil::importProjectExGraphicsInto(config, temporary_patched_rom_path,
+				GraphicsUtil::getCleanRomFingerprints(config, true));
 		}
+
+		cachePatchedRom(bps_hash, base_hash);
 	}
 
 	void FlipsInsertable::insert() {
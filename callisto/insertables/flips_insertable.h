@@ -2,24 +2,33 @@
 
 #include <string>
 #include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <optional>
 
 #include <spdlog/spdlog.h>
 #include <fmt/format.h>
 
-#include <boost/process/system.hpp>
+#include <nlohmann/json.hpp>
 
 #include "lunar_magic_insertable.h"
 #include "../not_found_exception.h"
 #include "../insertion_exception.h"
 #include "rom_insertable.h"
+#include "../bps/bps.h"
 
 #include "../graphics_util.h"
+#include "../graphics_manifest.h"
+#include "../hash_util.h"
+#include "../file_util.h"
+#include "../path_util.h"
+#include "../subprocess.h"
 
 #include "../configuration/configuration.h"
 #include "../dependency/policy.h"
 
-namespace bp = boost::process;
 namespace fs = std::filesystem;
+using json = nlohmann::json;
 
 namespace callisto {
 	class FlipsInsertable : public LunarMagicInsertable {
@@ -36,6 +45,12 @@ namespace callisto {
 
 		fs::path getTemporaryPatchedRomPath() const;
 		fs::path createTemporaryPatchedRom() const;
+
+		// Hash of everything besides the BPS patch that goes into the patched ROM, i.e. the clean ROM and imported graphics
+		std::string determineBaseHash() const;
+		fs::path getCachedPatchedRomPath() const;
+		bool tryRestoreCachedPatchedRom(const std::string& bps_hash, const std::string& base_hash) const;
+		void cachePatchedRom(const std::string& bps_hash, const std::string& base_hash) const;
 		void deleteTemporaryPatchedRom(const fs::path& patched_rom_path) const;
 
 		virtual inline std::string getTemporaryPatchedRomPostfix() const = 0;
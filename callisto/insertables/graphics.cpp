@@ -23,6 +23,14 @@ namespace callisto {
 		return dependencies;
 	}
 
+	void Graphics::setPreviousFingerprints(const GraphicsUtil::Fingerprints& previous) {
+		previous_fingerprints = previous;
+	}
+
+	const GraphicsUtil::Fingerprints& Graphics::getFingerprints() const {
+		return fingerprints;
+	}
+
 	void Graphics::insert() {
 		checkLunarMagicExists();
 
@@ -46,7 +54,7 @@ namespace callisto {
 		));
 
 		try {
-			GraphicsUtil::importProjectGraphicsInto(config, temporary_rom_path);
+			fingerprints = GraphicsUtil::importProjectGraphicsInto(config, temporary_rom_path, previous_fingerprints);
 		}
 		catch (const std::exception& e) {
 			throw InsertionException(fmt::format(
@@ -23,14 +23,6 @@ namespace callisto {
 	}
 
 	void InitialPatch::insert(const fs::path& target_rom) {
-		if (!fs::exists(flips_path)) {
-			throw ToolNotFoundException(fmt::format(
-				colors::EXCEPTION,
-				"FLIPS not found at {}",
-				flips_path.string()
-			));
-		}
-
 		if (!fs::exists(clean_rom_path)) {
 			throw NotFoundException(fmt::format(
 				colors::EXCEPTION,
@@ -49,13 +41,30 @@ namespace callisto {
 
 		spdlog::info(fmt::format(colors::RESOURCE, "Applying initial patch {}", initial_patch_path.string()));
 
-		int exit_code{ bp::system(
-			flips_path.string(),
+		try {
+			const auto result{ Bps::applyFile(initial_patch_path, clean_rom_path, target_rom) };
+			spdlog::debug("Initial patch changed {} range(s) of the clean ROM", result.changed_ranges.size());
+			spdlog::info(fmt::format(colors::PARTIAL_SUCCESS, "Successfully applied initial patch!"));
+			return;
+		}
+		catch (const BpsException& e) {
+			spdlog::debug("Failed to apply initial patch directly, falling back to FLIPS: {}", e.what());
+		}
+
+		if (!fs::exists(flips_path)) {
+			throw ToolNotFoundException(fmt::format(
+				colors::EXCEPTION,
+				"FLIPS not found at {}",
+				flips_path.string()
+			));
+		}
+
+		const auto exit_code{ Subprocess::run(flips_path, {
 			"--apply",
 			initial_patch_path.string(),
 			clean_rom_path.string(),
 			target_rom.string()
-		) };
+		}).exit_code };
 
 		if (exit_code != 0) {
 			throw InsertionException(fmt::format(
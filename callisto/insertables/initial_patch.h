@@ -4,15 +4,15 @@
 
 #include <spdlog/spdlog.h>
 #include <fmt/format.h>
-#include <boost/process/system.hpp>
 
 #include "rom_insertable.h"
+#include "../bps/bps.h"
 #include "../configuration/configuration.h"
 #include "../insertion_exception.h"
+#include "../subprocess.h"
 #include "../dependency/policy.h"
 #include "../dependency/resource_dependency.h"
 
-namespace bp = boost::process;
 namespace fs = std::filesystem;
 
 namespace callisto {
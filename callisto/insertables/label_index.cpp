@@ -0,0 +1,20 @@
+#include "label_index.h"
+
+namespace callisto {
+	LabelIndex::LabelIndex(const std::vector<size_t>& label_locations) {
+		// uggo but labels can have the bank byte be | $80 or not depending on how the user does things I think?
+		// not sure how this affects sa1 ROMs but I'm guessing it's a niche issue if anything (hopefully not wrong)
+		// so we index both variants
+		locations.reserve(2 * label_locations.size());
+		for (const auto location : label_locations) {
+			locations.push_back(location);
+			locations.push_back(location | 0x800000);
+		}
+		std::sort(locations.begin(), locations.end());
+	}
+
+	bool LabelIndex::containsAnyIn(size_t start_snes, size_t end_snes) const {
+		const auto first_label_in_block{ std::lower_bound(locations.begin(), locations.end(), start_snes) };
+		return first_label_in_block != locations.end() && *first_label_in_block < end_snes;
+	}
+}
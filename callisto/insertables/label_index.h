@@ -0,0 +1,19 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+namespace callisto {
+	// Label locations sorted once, so checking whether a written block holds a label is a binary search
+	// instead of a pass over every label
+	class LabelIndex {
+	protected:
+		std::vector<size_t> locations{};
+
+	public:
+		explicit LabelIndex(const std::vector<size_t>& label_locations);
+
+		// Whether any label lies in [start_snes, end_snes)
+		bool containsAnyIn(size_t start_snes, size_t end_snes) const;
+	};
+}
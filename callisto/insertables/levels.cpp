@@ -15,7 +15,9 @@ namespace callisto {
 		}
 	}
 
-	void Levels::normalizeMwls(const fs::path& levels_folder_path, bool allow_user_input) {
+	void Levels::normalizeMwls(const fs::path& levels_folder_path, const fs::path& project_root, bool allow_user_input) {
+		const auto internal_level_numbers{ MwlIndex::getInternalLevelNumbers(levels_folder_path, project_root) };
+
 		for (const auto& entry : fs::directory_iterator(levels_folder_path)) {
 			const auto path{ entry.path() };
 
@@ -35,7 +37,8 @@ namespace callisto {
 				));
 			}
 
-			const auto mwl_level_number{ getInternalLevelNumber(path) };
+			const auto indexed{ internal_level_numbers.find(path) };
+			const auto mwl_level_number{ indexed != internal_level_numbers.end() ? indexed->second : getInternalLevelNumber(path) };
 			if (!mwl_level_number.has_value()) {
 				throw InsertionException(fmt::format(
 					colors::EXCEPTION,
@@ -321,6 +324,40 @@ namespace callisto {
 		return dependencies;
 	}
 
+	Levels::Fingerprints Levels::determineFingerprints() const {
+		Fingerprints current{};
+		for (const auto& entry : fs::directory_iterator(levels_folder)) {
+			if (entry.path().extension() == ".mwl") {
+				current.emplace(entry.path().filename().string(), HashUtil::hashFile(entry.path()));
+			}
+		}
+		return current;
+	}
+
+	void Levels::setPreviousFingerprints(const Fingerprints& previous) {
+		previous_fingerprints = previous;
+	}
+
+	const Levels::Fingerprints& Levels::getFingerprints() const {
+		return fingerprints;
+	}
+
+	int Levels::importLevelsFrom(const fs::path& folder) {
+		if (import_flag.has_value()) {
+			return callLunarMagic(
+				"-ImportMultLevels",
+				temporary_rom_path.string(),
+				folder.string(),
+				import_flag.value());
+		}
+		else {
+			return callLunarMagic(
+				"-ImportMultLevels",
+				temporary_rom_path.string(),
+				folder.string());
+		}
+	}
+
 	void Levels::insert() {
 		checkLunarMagicExists();
 
@@ -334,40 +371,58 @@ namespace callisto {
 
 		spdlog::info(fmt::format(colors::RESOURCE, "Inserting levels"));
 
-		bool at_least_one_level{ false };
-		for (const auto& entry : fs::directory_iterator(levels_folder)) {
-			if (entry.path().extension() == ".mwl") {
-				at_least_one_level = true;
-				break;
-			}
-		}
+		fingerprints = determineFingerprints();
 
-		if (!at_least_one_level) {
+		if (fingerprints.empty()) {
 			spdlog::info(fmt::format(colors::PARTIAL_SUCCESS, "No levels to insert, skipping level insertion"));
 			return;
 		}
 
-		int exit_code;
+		auto import_folder{ levels_folder };
+		std::optional<fs::path> staging_folder{};
 
-		if (import_flag.has_value()) {
-			exit_code = callLunarMagic(
-				"-ImportMultLevels",
-				temporary_rom_path.string(),
-				levels_folder.string(),
-				import_flag.value());
+		if (previous_fingerprints.has_value()) {
+			std::vector<std::string> changed{};
+			for (const auto& [file_name, hash] : fingerprints) {
+				const auto previous{ previous_fingerprints.value().find(file_name) };
+				if (previous == previous_fingerprints.value().end() || previous->second != hash) {
+					changed.push_back(file_name);
+				}
+			}
+
+			if (changed.empty()) {
+				spdlog::info(fmt::format(colors::PARTIAL_SUCCESS, "No level files changed, skipping level insertion"));
+				return;
+			}
+
+			// removed levels never get here, those force a rebuild, so everything that wasn't changed is already in the ROM
+			if (changed.size() != fingerprints.size()) {
+				staging_folder = temporary_rom_path.parent_path() / STAGING_FOLDER_NAME;
+				fs::remove_all(staging_folder.value());
+				fs::create_directories(staging_folder.value());
+
+				for (const auto& file_name : changed) {
+					fs::copy_file(levels_folder / file_name, staging_folder.value() / file_name);
+				}
+
+				import_folder = staging_folder.value();
+				spdlog::info(fmt::format(colors::NOTIFICATION, "{} of {} level file{} changed, only importing {}",
+					changed.size(), fingerprints.size(), fingerprints.size() == 1 ? "" : "s", changed.size() == 1 ? "it" : "those"));
+			}
 		}
-		else {
-			exit_code = callLunarMagic(
-				"-ImportMultLevels",
-				temporary_rom_path.string(),
-				levels_folder.string());
+
+		const auto exit_code{ importLevelsFrom(import_folder) };
+
+		if (staging_folder.has_value()) {
+			std::error_code ec;
+			fs::remove_all(staging_folder.value(), ec);
 		}
 
 		if (exit_code == 0) {
 			spdlog::info(fmt::format(colors::PARTIAL_SUCCESS, "Successfully inserted levels"));
 			spdlog::debug(fmt::format(
 				"Successfully inserted levels from folder {} into temporary ROM {}",
-				levels_folder.string(),
+				import_folder.string(),
 				temporary_rom_path.string()
 			));
 		}
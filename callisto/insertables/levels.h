@@ -3,6 +3,7 @@
 #include <filesystem>
 #include <optional>
 #include <functional>
+#include <map>
 
 #include <fmt/core.h>
 
@@ -11,6 +12,8 @@
 #include "lunar_magic_insertable.h"
 #include "../insertion_exception.h"
 #include "../not_found_exception.h"
+#include "../hash_util.h"
+#include "mwl_index.h"
 
 #include "../configuration/configuration.h"
 #include "../dependency/policy.h"
@@ -19,12 +22,23 @@ namespace fs = std::filesystem;
 
 namespace callisto {
 	class Levels : public LunarMagicInsertable {
+	public:
+		// MWL file name -> hash of its contents
+		using Fingerprints = std::map<std::string, std::string>;
+
 	protected:
 		static constexpr auto MWL_DATA_POINTER_TABLE_POINTER_OFFSET{ 0x4 };
+		static constexpr auto STAGING_FOLDER_NAME{ "changed_levels" };
 
 		const fs::path levels_folder;
 		std::optional<std::string> import_flag;
 
+		std::optional<Fingerprints> previous_fingerprints{};
+		Fingerprints fingerprints{};
+
+		Fingerprints determineFingerprints() const;
+		int importLevelsFrom(const fs::path& folder);
+
 		static size_t readBytesAt(std::fstream& stream, size_t offset, size_t count);
 
 		static std::optional<int> getExternalLevelNumber(const fs::path& mwl_path);
@@ -34,10 +48,14 @@ namespace callisto {
 
 	public:
 		static std::optional<int> getInternalLevelNumber(const fs::path& mwl_path);
-		static void normalizeMwls(const fs::path& levels_folder_path, bool allow_user_input);
+		static void normalizeMwls(const fs::path& levels_folder_path, const fs::path& project_root, bool allow_user_input);
 
 		void insert() override;
 
+		// Only MWLs whose fingerprint differs from the passed one will be imported on insertion
+		void setPreviousFingerprints(const Fingerprints& previous);
+		const Fingerprints& getFingerprints() const;
+
 		Levels(const Configuration& config);
 	};
 }
@@ -10,6 +10,14 @@ namespace callisto {
 		return { ResourceDependency(lunar_magic_path, Policy::REBUILD) };
 	}
 
+	std::optional<std::vector<fs::path>> LunarMagicInsertable::getKnownInputPaths() {
+		std::vector<fs::path> input_paths{};
+		for (const auto& dependency : determineDependencies()) {
+			input_paths.push_back(dependency.dependent_path);
+		}
+		return input_paths;
+	}
+
 	void LunarMagicInsertable::checkLunarMagicExists() {
 		if (!fs::exists(lunar_magic_path)) {
 			throw ToolNotFoundException(fmt::format(
@@ -5,16 +5,14 @@
 
 #include <fmt/format.h>
 
-#include <boost/process/system.hpp>
-
 #include "../insertable.h"
 #include "../not_found_exception.h"
 #include "rom_insertable.h"
 
 #include "../configuration/configuration.h"
+#include "../subprocess.h"
 #include "../dependency/policy.h"
 
-namespace bp = boost::process;
 namespace fs = std::filesystem;
 
 namespace callisto {
@@ -26,11 +24,15 @@ namespace callisto {
 
 		template<typename... Args>
 		int callLunarMagic(Args... args) {
-			return bp::system(lunar_magic_path.string(), args...);
+			return Subprocess::run(lunar_magic_path, { std::string(args)... }).exit_code;
 		}
 
 		std::unordered_set<ResourceDependency> determineDependencies() override;
 
 		void checkLunarMagicExists();
+
+	public:
+		// everything these read follows from the configuration, so it's known without inserting first
+		std::optional<std::vector<fs::path>> getKnownInputPaths() override;
 	};
 }
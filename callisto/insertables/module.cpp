@@ -16,10 +16,12 @@ namespace callisto {
 		cleanup_folder_location(PathUtil::getModuleCleanupDirectoryPath(config.project_root.getOrThrow())),
 		current_module_addresses(current_module_addresses),
 		additional_include_paths(additional_include_paths),
+		context(ExecutionContext(config).withBaseDirectory(temporary_rom_path.parent_path())),
 		id(id),
 		module_header_file(registerConfigurationDependency(config.module_header, Policy::REINSERT).isSet() ? 
 			std::make_optional(config.module_header.getOrThrow()) : std::nullopt),
-		disable_deprecation_warnings(config.disable_deprecation_warnings.getOrDefault(false))
+		disable_deprecation_warnings(config.disable_deprecation_warnings.getOrDefault(false)),
+		reserve_freespace(registerConfigurationDependency(config.reserve_module_freespace).getOrDefault(true))
 	{
 		for (const auto& output_path : output_paths) {
 			fs::create_directories(output_path.parent_path());
@@ -66,16 +68,15 @@ namespace callisto {
 				));
 		}
 
-		const auto prev_folder{ fs::current_path() };
-		fs::current_path(temporary_rom_path.parent_path());
-
 		// delete potential previous dependency report
 		fs::remove(temporary_rom_path.parent_path() / ".dependencies");
 
 		spdlog::info(fmt::format(colors::RESOURCE, "Inserting module {}", project_relative_path.string()));
 
+		// asar only needs the patch to have a path, making it absolute keeps it from depending on our working directory
+		const auto memory_patch_path{ context.resolve("temp.asm").string() };
 		memoryfile patch;
-		patch.path = "temp.asm";
+		patch.path = memory_patch_path.c_str();
 		patch.buffer = patch_string.c_str();
 		patch.length = patch_string.size();
 
@@ -134,7 +135,7 @@ namespace callisto {
 
 		const patchparams params{
 			sizeof(struct patchparams),
-			"temp.asm",
+			memory_patch_path.c_str(),
 			rom_bytes.data(),
 			MAX_ROM_SIZE,
 			&unheadered_rom_size,
@@ -160,8 +161,35 @@ namespace callisto {
 			));
 		}
 
+		// fence off every gap in front of where the module used to be, so asar's first fit search 
+		// lands on the old location again as long as the module still fits there
+		const auto fences{ previous_placement.has_value() && !previous_placement.value().areas.empty()
+			&& usesLoRomFreespaceSearch(rom_bytes, unheadered_rom_size)
+			? fenceFreespace(rom_bytes, std::min(static_cast<size_t>(unheadered_rom_size),
+				std::min_element(previous_placement.value().areas.begin(), previous_placement.value().areas.end())->first))
+			: std::vector<Fence>() };
+
+		// the fenced search only knows about gaps after the old location, so keep what we need to retry without it
+		std::vector<char> unfenced_rom{};
+		const auto unfenced_rom_size{ unheadered_rom_size };
+		if (!fences.empty()) {
+			unfenced_rom.assign(rom_bytes.begin(), rom_bytes.begin() + unheadered_rom_size);
+			removeFences(unfenced_rom, fences);
+		}
+
 		asar_reset();
-		const bool succeeded{ asar_patch_ex(&params) };
+		bool succeeded{ asar_patch_ex(&params) };
+
+		removeFences(rom_bytes, fences);
+
+		if (!succeeded && !fences.empty()) {
+			spdlog::debug("Module {} failed to apply behind its previous location, retrying with all freespace available", 
+				project_relative_path.string());
+			std::copy(unfenced_rom.begin(), unfenced_rom.end(), rom_bytes.begin());
+			unheadered_rom_size = unfenced_rom_size;
+			asar_reset();
+			succeeded = asar_patch_ex(&params);
+		}
 
 		for (auto c_str : as_c_strs) {
 			delete[] c_str;
@@ -199,6 +227,8 @@ namespace callisto {
 			
 			verifyWrittenBlockCoverage(rom_bytes);
 
+			determinePlacement(rom_bytes, unheadered_rom_size);
+
 			std::ofstream out_rom{ temporary_rom_path, std::ios::out | std::ios::binary };
 			out_rom.write(header.data(), header_size);
 			out_rom.write(rom_bytes.data(), unheadered_rom_size);
@@ -207,10 +237,9 @@ namespace callisto {
 
 			emitOutputFiles();
 			emitPlainAddressFile();
+			emitPlacementFile();
 
 			current_module_addresses->insert(our_module_addresses.begin(), our_module_addresses.end());
-
-			fs::current_path(prev_folder);
 		}
 		else {
 			int error_count;
@@ -224,7 +253,6 @@ namespace callisto {
 				error_string << errors[i].fullerrdata;
 			}
 
-			fs::current_path(prev_folder);
 			throw InsertionException(fmt::format(
 				colors::EXCEPTION,
 				"Failed to apply module {} with the following error(s):\n\r{}",
@@ -248,9 +276,10 @@ namespace callisto {
 	}
 
 	void Module::emitOutputFile(const fs::path& output_path) const {
-		std::ofstream real_output_file{ output_path };
+		// built in memory first so we only touch the file (and its timestamp) if the labels actually 
+		// changed, otherwise every patch including this output would be reinserted on the next update
+		std::ostringstream real_output_file{};
 
-		auto name{ output_path.string() };
 		real_output_file << fmt::format("if not(defined(\"CALLISTO_MODULE_{}\"))\n\n!CALLISTO_MODULE_{} = 1\n\n", id, id);
 
 		real_output_file << fmt::format("incsrc \"{}\"\n\n", PathUtil::sanitizeForAsar(PathUtil::convertToPosixPath(callisto_asm_file)).string());
@@ -284,43 +313,207 @@ namespace callisto {
 			real_output_file << fmt::format("!{} = ${:06X}", module_name, label.location) << std::endl;
 		}
 		else {
-			for (int i{ 0 }; i != label_number; ++i) {
-				const auto& label{ labels[i] };
-				const auto name{ std::string(label.name) };
+			for (const auto& [name, location] : our_labels) {
+				real_output_file << fmt::format("{}_{} = ${:06X}", module_name, name, location) << std::endl;
+				real_output_file << fmt::format("!{}_{} = ${:06X}", module_name, name, location) << std::endl;
+			}
+		}
 
-				if (name.at(0) == ':') {
-					// it's a relative label (+, -, ++, ...), skip it
-					continue;
-				}
+		real_output_file << "\nendif\n";
 
-				if (name.find('.') != std::string::npos) {
-					// it's a struct field (Struct.field), skip it
-					continue;
-				}
+		FileUtil::writeIfDifferent(real_output_file.str(), output_path);
+	}
+
+	fs::path Module::getCleanupFilePath(const std::string& extension) const {
+		return cleanup_folder_location / ((project_relative_path.parent_path() / project_relative_path.stem()).string() + extension);
+	}
+
+	void Module::emitPlainAddressFile() const {
+		const auto cleanup_file_path{ getCleanupFilePath(".addr") };
+
+		fs::create_directories(cleanup_file_path.parent_path());
 
-				if (current_module_addresses->contains(label.location)) {
-					// label belongs to imported module, skip it
+		std::vector<int> sorted_addresses(our_module_addresses.begin(), our_module_addresses.end());
+		std::sort(sorted_addresses.begin(), sorted_addresses.end());
+
+		std::ostringstream cleanup_file{};
+		for (const auto& address : sorted_addresses) {
+			cleanup_file << fmt::format("{}\n", address);
+		}
+
+		FileUtil::writeIfDifferent(cleanup_file.str(), cleanup_file_path);
+	}
+
+	void Module::emitPlacementFile() const {
+		const auto placement_file_path{ getCleanupFilePath(".place") };
+
+		fs::create_directories(placement_file_path.parent_path());
+
+		std::ostringstream placement_file{};
+		for (const auto& [pc_address, size] : placement.areas) {
+			placement_file << fmt::format("area {} {}\n", pc_address, size);
+		}
+		for (const auto& [pc_address, size] : placement.reservations) {
+			placement_file << fmt::format("reservation {} {}\n", pc_address, size);
+		}
+
+		FileUtil::writeIfDifferent(placement_file.str(), placement_file_path);
+	}
+
+	std::optional<Module::Placement> Module::readPlacementFile(const fs::path& placement_file_path) {
+		std::ifstream placement_file{ placement_file_path };
+		if (!placement_file) {
+			return {};
+		}
+
+		Placement placement{};
+		std::string kind;
+		size_t pc_address;
+		size_t size;
+		while (placement_file >> kind >> pc_address >> size) {
+			if (kind == "area") {
+				placement.areas.emplace_back(pc_address, size);
+			}
+			else if (kind == "reservation") {
+				placement.reservations.emplace_back(pc_address, size);
+			}
+		}
+
+		return placement;
+	}
+
+	void Module::releaseReservations(const Placement& placement, char* rom, size_t rom_size) {
+		const std::vector<char> tag_bytes(RATS_TAG_SIZE);
+		for (const auto& [pc_address, size] : placement.reservations) {
+			if (pc_address + RATS_TAG_SIZE > rom_size) {
+				continue;
+			}
+
+			// only release the reservation if it's still exactly the tag we wrote, anything else means 
+			// someone else moved things around in the meantime and we'd better leave it alone
+			const std::vector<char> tag(rom + pc_address, rom + pc_address + RATS_TAG_SIZE);
+			const auto block_size{ determineFreespaceBlockSize(0, tag) };
+			if (block_size.has_value() && block_size.value() + RATS_TAG_SIZE == size) {
+				std::fill(rom + pc_address, rom + pc_address + RATS_TAG_SIZE, 0);
+			}
+		}
+	}
+
+	void Module::writeRatsTag(char* rom, size_t pc_address, size_t data_size) {
+		const auto size_field{ static_cast<uint16_t>(data_size - 1) };
+		const auto complement{ static_cast<uint16_t>(size_field ^ 0xFFFF) };
+		std::copy(RATS_TAG_TEXT, RATS_TAG_TEXT + 4, rom + pc_address);
+		rom[pc_address + 4] = static_cast<char>(size_field & 0xFF);
+		rom[pc_address + 5] = static_cast<char>(size_field >> 8);
+		rom[pc_address + 6] = static_cast<char>(complement & 0xFF);
+		rom[pc_address + 7] = static_cast<char>(complement >> 8);
+	}
+
+	bool Module::usesLoRomFreespaceSearch(const std::vector<char>& rom, size_t rom_size) {
+		if (rom_size <= LOROM_MAP_MODE_PC) {
+			return false;
+		}
+
+		// only plain LoROM (slow or fast) is known to search for freespace from FREESPACE_SEARCH_START upwards,
+		// SA-1 and the other mappers just don't get the placement preference
+		const auto map_mode{ static_cast<unsigned char>(rom[LOROM_MAP_MODE_PC]) };
+		return map_mode == 0x20 || map_mode == 0x30;
+	}
+
+	std::vector<Module::Fence> Module::fenceFreespace(std::vector<char>& rom, size_t end_pc) {
+		std::vector<Fence> fences{};
+
+		size_t pc{ FREESPACE_SEARCH_START };
+		while (pc < end_pc) {
+			if (rom[pc] == RATS_TAG_TEXT[0]) {
+				const auto protected_size{ determineFreespaceBlockSize(pc, rom) };
+				if (protected_size.has_value()) {
+					pc += RATS_TAG_SIZE + protected_size.value();
 					continue;
 				}
+			}
+
+			// asar considers runs of its freespace byte free, which is $00 unless the module says otherwise, 
+			// $FF is covered too in case it does, we put back whatever we overwrite anyway
+			const auto byte{ static_cast<unsigned char>(rom[pc]) };
+			if (byte != 0x00 && byte != 0xFF) {
+				++pc;
+				continue;
+			}
+
+			const auto run_limit{ std::min(end_pc, (pc / PC_BANK_SIZE + 1) * PC_BANK_SIZE) };
+			auto run_end{ pc };
+			while (run_end != run_limit && static_cast<unsigned char>(rom[run_end]) == byte) {
+				++run_end;
+			}
 
-				real_output_file << fmt::format("{}_{} = ${:06X}", module_name, name, label.location) << std::endl;
-				real_output_file << fmt::format("!{}_{} = ${:06X}", module_name, name, label.location) << std::endl;
+			if (run_end - pc > RATS_TAG_SIZE) {
+				Fence fence{ pc, {} };
+				std::copy(rom.begin() + pc, rom.begin() + pc + RATS_TAG_SIZE, fence.second.begin());
+				fences.push_back(fence);
+				writeRatsTag(rom.data(), pc, run_end - pc - RATS_TAG_SIZE);
 			}
+
+			pc = run_end;
 		}
 
-		real_output_file << "\nendif\n";
+		spdlog::debug("Placed {} temporary freespace fences up to ${:06X} (unheadered)", fences.size(), end_pc);
+
+		return fences;
 	}
 
-	void Module::emitPlainAddressFile() const {
-		const auto cleanup_file_path{ 
-			cleanup_folder_location / ((project_relative_path.parent_path() / project_relative_path.stem()).string() + ".addr")};
+	void Module::removeFences(std::vector<char>& rom, const std::vector<Fence>& fences) {
+		for (const auto& [pc_address, original_bytes] : fences) {
+			std::copy(original_bytes.begin(), original_bytes.end(), rom.begin() + pc_address);
+		}
+	}
 
-		fs::create_directories(cleanup_file_path.parent_path());
+	void Module::determinePlacement(std::vector<char>& rom, size_t rom_size) {
+		placement = Placement();
+
+		int block_count{};
+		const auto written_blocks{ asar_getwrittenblocks(&block_count) };
+		const auto freespace_areas{ convertToFreespaceAreas(convertToWrittenBlockVector(written_blocks, block_count), rom) };
 
-		std::ofstream cleanup_file{ cleanup_file_path };
+		for (const auto& freespace_area : freespace_areas) {
+			const auto start{ freespace_area.front().start_pc };
+			const auto data_size{ determineFreespaceBlockSize(start, rom) };
+			if (!data_size.has_value()) {
+				continue;
+			}
+			placement.areas.emplace_back(start, data_size.value() + RATS_TAG_SIZE);
+		}
 
-		for (const auto& address : our_module_addresses) {
-			cleanup_file << fmt::format("{}\n", address);
+		if (previous_placement.has_value() && !placement.areas.empty()) {
+			const auto moved{ std::min_element(placement.areas.begin(), placement.areas.end())->first !=
+				std::min_element(previous_placement.value().areas.begin(), previous_placement.value().areas.end())->first };
+			if (moved) {
+				spdlog::info(fmt::format(colors::NOTIFICATION, 
+					"Module {} no longer fits at its previous location and has been moved", project_relative_path.string()));
+			}
+		}
+
+		if (!reserve_freespace) {
+			return;
+		}
+
+		// reserve some slack right behind each area so small size increases still fit in place next time
+		for (const auto& [start, size] : placement.areas) {
+			const auto reservation_start{ start + size };
+			const auto desired_size{ std::clamp(size / 8, MIN_RESERVATION_SIZE, MAX_RESERVATION_SIZE) + RATS_TAG_SIZE };
+			const auto limit{ std::min({ reservation_start + desired_size, 
+				(reservation_start / PC_BANK_SIZE + 1) * PC_BANK_SIZE, rom_size }) };
+
+			auto free_end{ reservation_start };
+			while (free_end < limit && rom[free_end] == 0x00) {
+				++free_end;
+			}
+
+			const auto reservation_size{ free_end - reservation_start };
+			if (reservation_size > RATS_TAG_SIZE) {
+				writeRatsTag(rom.data(), reservation_start, reservation_size - RATS_TAG_SIZE);
+				placement.reservations.emplace_back(reservation_start, reservation_size);
+			}
 		}
 	}
 
@@ -347,6 +540,9 @@ namespace callisto {
 		int label_count{};
 		const auto labels{ asar_getalllabels(&label_count) };
 
+		our_labels.clear();
+		our_labels.reserve(label_count);
+
 		for (int i{ 0 }; i != label_count; ++i) {
 			const auto& label{ labels[i] };
 			const auto name{ std::string(label.name) };
@@ -367,35 +563,32 @@ namespace callisto {
 			}
 
 			our_module_addresses.insert(label.location);
+			our_labels.emplace_back(name, label.location);
 		}
+
+		// keeps emitted output stable between insertions regardless of the order asar hands labels to us in
+		std::sort(our_labels.begin(), our_labels.end());
 	}
 
 	void Module::verifyWrittenBlockCoverage(const std::vector<char>& rom) const {
 		int label_count{};
 		const auto labels{ asar_getalllabels(&label_count) };
 
+		std::vector<size_t> label_locations{};
+		label_locations.reserve(static_cast<size_t>(label_count));
+		for (int i{ 0 }; i != label_count; ++i) {
+			label_locations.push_back(static_cast<size_t>(labels[i].location));
+		}
+		const LabelIndex label_index{ label_locations };
+
 		int block_count{};
 		const auto written_blocks{ asar_getwrittenblocks(&block_count) };
 		const auto as_structs{ convertToWrittenBlockVector(written_blocks, block_count) };
 		const auto freespace_areas{ convertToFreespaceAreas(as_structs, rom) };
 		for (const auto& freespace_area : freespace_areas) {
-			bool is_covered{ false };
-			for (const auto& written_block : freespace_area) {
-				for (int j{ 0 }; j != label_count; ++j) {
-					// uggo but labels can have the bank byte be | $80 or not depending on how the user does things I think?
-					// not sure how this affects sa1 ROMs but I'm guessing it's a niche issue if anything (hopefully not wrong)
-					const auto location_low{ labels[j].location };
-					const auto location_high{ labels[j].location | 0x800000 };
-					if ((location_low >= written_block.start_snes && location_low < written_block.end_snes) 
-						|| (location_high >= written_block.start_snes && location_high < written_block.end_snes)) {
-						is_covered = true;
-						break;
-					}
-				}
-				if (is_covered) {
-					break;
-				}
-			}
+			const auto is_covered{ std::any_of(freespace_area.begin(), freespace_area.end(), [&](const WrittenBlock& written_block) {
+				return label_index.containsAnyIn(written_block.start_snes, written_block.end_snes);
+			}) };
 
 			if (!is_covered) {
 				auto freespace_start{ freespace_area.front().start_snes + RATS_TAG_SIZE };
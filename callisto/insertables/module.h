@@ -6,6 +6,8 @@
 #include <iterator>
 #include <unordered_set>
 #include <optional>
+#include <algorithm>
+#include <array>
 
 #include <fmt/core.h>
 #include <spdlog/spdlog.h>
@@ -14,11 +16,14 @@
 #include <boost/filesystem.hpp>
 
 #include "rom_insertable.h"
+#include "label_index.h"
 #include "../insertion_exception.h"
 #include "../not_found_exception.h"
 
 #include "../configuration/configuration.h"
 #include "../dependency/policy.h"
+#include "../file_util.h"
+#include "../execution_context.h"
 
 namespace fs = std::filesystem;
 
@@ -30,6 +35,15 @@ namespace callisto {
 		static constexpr auto RATS_TAG_TEXT{ "STAR" };
 		static constexpr auto RATS_TAG_SIZE{ 8 };
 
+		// on LoROM asar only hands out freespace from bank $10 onwards, so that's where we start fencing off gaps,
+		// other mappers aren't fenced at all, see usesLoRomFreespaceSearch
+		static constexpr size_t FREESPACE_SEARCH_START{ 0x80000 };
+		// map mode byte of the internal header at $00:FFD5
+		static constexpr size_t LOROM_MAP_MODE_PC{ 0x7FD5 };
+		static constexpr size_t PC_BANK_SIZE{ 0x8000 };
+		static constexpr size_t MIN_RESERVATION_SIZE{ 0x40 };
+		static constexpr size_t MAX_RESERVATION_SIZE{ 0x800 };
+
 		struct WrittenBlock {
 			WrittenBlock(size_t start_pc, size_t start_snes, size_t size)
 				: start_pc(start_pc), end_pc(start_pc + size), size(size), start_snes(start_snes), end_snes(start_snes + size) {};
@@ -42,15 +56,31 @@ namespace callisto {
 			size_t size;
 		};
 		using FreespaceArea = std::vector<WrittenBlock>;
+		using Fence = std::pair<size_t, std::array<char, RATS_TAG_SIZE>>;
+
+	public:
+		// pc offset and size (including RATS tag) of every freespace area a module occupied and
+		// every block callisto reserved right after them so the module can grow in place
+		struct Placement {
+			std::vector<std::pair<size_t, size_t>> areas{};
+			std::vector<std::pair<size_t, size_t>> reservations{};
+		};
+
+	protected:
 
 		std::string patch_string{};
 
 		const int id;
 
 		const bool disable_deprecation_warnings;
+		const bool reserve_freespace;
+
+		std::optional<Placement> previous_placement{};
+		Placement placement{};
 
 		std::shared_ptr<std::unordered_set<int>> current_module_addresses;
 		std::unordered_set<int> our_module_addresses{};
+		std::vector<std::pair<std::string, int>> our_labels{};
 
 		const fs::path input_path;
 		const std::vector<fs::path> output_paths;
@@ -61,6 +91,7 @@ namespace callisto {
 		const fs::path project_relative_path;
 
 		std::vector<fs::path> additional_include_paths;
+		const ExecutionContext context;
 
 		const fs::path callisto_asm_file;
 		const std::optional<fs::path> module_header_file;
@@ -68,6 +99,8 @@ namespace callisto {
 		void emitOutputFiles() const;
 		void emitOutputFile(const fs::path& output_path) const;
 		void emitPlainAddressFile() const;
+		void emitPlacementFile() const;
+		fs::path getCleanupFilePath(const std::string& extension) const;
 
 		std::unordered_set<ResourceDependency> determineDependencies() override;
 
@@ -81,6 +114,12 @@ namespace callisto {
 		static std::vector<WrittenBlock> convertToWrittenBlockVector(const writtenblockdata* const written_blocks, int block_count);
 		static std::vector<FreespaceArea> convertToFreespaceAreas(const std::vector<WrittenBlock>& written_blocks, const std::vector<char>& rom);
 
+		void determinePlacement(std::vector<char>& rom, size_t rom_size);
+		static void writeRatsTag(char* rom, size_t pc_address, size_t data_size);
+		static bool usesLoRomFreespaceSearch(const std::vector<char>& rom, size_t rom_size);
+		static std::vector<Fence> fenceFreespace(std::vector<char>& rom, size_t end_pc);
+		static void removeFences(std::vector<char>& rom, const std::vector<Fence>& fences);
+
 	public:
 		static std::string modulePathToName(const fs::path& path);
 
@@ -88,6 +127,15 @@ namespace callisto {
 			return output_paths;
 		};
 
+		// Makes the next insertion try to put this module back where it used to be, 
+		// the previous placement's reservations must already have been released
+		void setPreviousPlacement(const Placement& placement) {
+			previous_placement = placement;
+		}
+
+		static std::optional<Placement> readPlacementFile(const fs::path& placement_file_path);
+		static void releaseReservations(const Placement& placement, char* rom, size_t rom_size);
+
 		Module(const Configuration& config,
 			const fs::path& input_path,
 			const fs::path& callisto_asm_file,
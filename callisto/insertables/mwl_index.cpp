@@ -0,0 +1,113 @@
+#include "mwl_index.h"
+#include "levels.h"
+
+namespace callisto {
+	std::map<std::string, MwlIndex::Entry> MwlIndex::readIndex(const fs::path& index_path) {
+		std::map<std::string, Entry> entries{};
+
+		if (!fs::exists(index_path)) {
+			return entries;
+		}
+
+		try {
+			std::ifstream file{ index_path };
+			const auto j{ json::parse(file) };
+
+			if (j.value("version", 0) != INDEX_VERSION) {
+				return entries;
+			}
+
+			for (const auto& [path, entry] : j["files"].items()) {
+				entries.emplace(path, Entry{
+					entry["size"].get<uintmax_t>(),
+					entry["timestamp"].get<int64_t>(),
+					entry["level"].is_null() ? std::nullopt : std::make_optional(entry["level"].get<int>())
+				});
+			}
+		}
+		catch (const json::exception& e) {
+			spdlog::debug("Failed to read MWL index at {}, starting over: {}", index_path.string(), e.what());
+			entries.clear();
+		}
+
+		return entries;
+	}
+
+	void MwlIndex::writeIndex(const fs::path& index_path, const std::map<std::string, Entry>& entries) {
+		json j;
+		j["version"] = INDEX_VERSION;
+		j["files"] = json::object();
+
+		for (const auto& [path, entry] : entries) {
+			j["files"][path] = {
+				{ "size", entry.size },
+				{ "timestamp", entry.last_write_time },
+				{ "level", entry.internal_level_number.has_value() ? json(entry.internal_level_number.value()) : json(nullptr) }
+			};
+		}
+
+		fs::create_directories(index_path.parent_path());
+		std::ofstream file{ index_path };
+		file << std::setw(4) << j << std::endl;
+	}
+
+	std::map<fs::path, std::optional<int>> MwlIndex::getInternalLevelNumbers(const fs::path& levels_folder, 
+		const fs::path& project_root) {
+		const auto index_path{ PathUtil::getMwlIndexPath(project_root) };
+		auto entries{ readIndex(index_path) };
+
+		std::map<fs::path, std::optional<int>> level_numbers{};
+		std::vector<std::pair<fs::path, Entry>> stale{};
+		std::map<std::string, Entry> current_entries{};
+
+		// size and timestamp come from the directory listing, so this doesn't open any files
+		for (const auto& dir_entry : fs::directory_iterator(levels_folder)) {
+			if (!dir_entry.is_regular_file() || dir_entry.path().extension() != ".mwl") {
+				continue;
+			}
+
+			const auto key{ fs::absolute(dir_entry.path()).string() };
+			const Entry current{ dir_entry.file_size(), static_cast<int64_t>(dir_entry.last_write_time().time_since_epoch().count()), {} };
+
+			const auto known{ entries.find(key) };
+			if (known != entries.end() && known->second.size == current.size 
+				&& known->second.last_write_time == current.last_write_time) {
+				level_numbers.emplace(dir_entry.path(), known->second.internal_level_number);
+				current_entries.emplace(key, known->second);
+			}
+			else {
+				stale.emplace_back(dir_entry.path(), current);
+			}
+		}
+
+		std::for_each(std::execution::par, stale.begin(), stale.end(), [](auto& path_and_entry) {
+			path_and_entry.second.internal_level_number = Levels::getInternalLevelNumber(path_and_entry.first);
+		});
+
+		for (const auto& [path, entry] : stale) {
+			level_numbers.emplace(path, entry.internal_level_number);
+			current_entries.emplace(fs::absolute(path).string(), entry);
+		}
+
+		spdlog::debug("Read level numbers of {} out of {} MWL files in {}", stale.size(), level_numbers.size(), levels_folder.string());
+
+		// drop whatever used to be in this folder but isn't anymore, keep entries for other folders as they are
+		const auto folder_prefix{ (fs::absolute(levels_folder) / "").string() };
+		const auto erased{ std::erase_if(entries, [&](const auto& entry) {
+			return entry.first.starts_with(folder_prefix);
+		}) };
+		const auto unchanged{ level_numbers.size() - stale.size() };
+		entries.merge(current_entries);
+
+		if (!stale.empty() || erased != unchanged) {
+			try {
+				writeIndex(index_path, entries);
+			}
+			catch (const std::exception& e) {
+				spdlog::debug("Failed to write MWL index to {}: {}", index_path.string(), e.what());
+			}
+		}
+
+		return level_numbers;
+	}
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <optional>
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <execution>
+
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include "../path_util.h"
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace callisto {
+	// Remembers the internal level number of every MWL in the levels folder alongside the file's size and 
+	// last write time, so MWLs that haven't been touched since we last looked at them don't need to be opened
+	class MwlIndex {
+	protected:
+		static constexpr auto INDEX_VERSION{ 1 };
+
+		struct Entry {
+			uintmax_t size;
+			int64_t last_write_time;
+			std::optional<int> internal_level_number;
+		};
+
+		static std::map<std::string, Entry> readIndex(const fs::path& index_path);
+		static void writeIndex(const fs::path& index_path, const std::map<std::string, Entry>& entries);
+
+	public:
+		// Returns the internal level number of every MWL file in the passed folder, or nothing for files
+		// that don't contain a valid one, files we haven't seen before or that changed are read in parallel
+		static std::map<fs::path, std::optional<int>> getInternalLevelNumbers(const fs::path& levels_folder, 
+			const fs::path& project_root);
+	};
+}
@@ -7,11 +7,19 @@ namespace callisto {
 		project_relative_path(fs::relative(patch_path, registerConfigurationDependency(config.project_root).getOrThrow())),
 		patch_path(patch_path),
 		additional_include_paths(additional_include_paths),
+		context(ExecutionContext(config).withBaseDirectory(patch_path.parent_path())),
+		write_set_path(PathUtil::getPatchWriteSetPath(config.project_root.getOrThrow(),
+			fs::relative(patch_path, config.project_root.getOrThrow()))),
 		disable_deprecation_warnings(config.disable_deprecation_warnings.getOrDefault(false))
 	{
 
 	}
 
+	void Patch::setPreviousWriteSet(const std::optional<WriteSet>& previous_write_set) {
+		previous_version_in_rom = true;
+		this->previous_write_set = previous_write_set;
+	}
+
 	void Patch::insert() {
 		if (!fs::exists(patch_path)) {
 			throw ResourceNotFoundException(fmt::format(
@@ -28,9 +36,6 @@ namespace callisto {
 				));
 		}
 
-		const auto prev_folder{ fs::current_path() };
-		fs::current_path(patch_path.parent_path());
-
 		spdlog::info(fmt::format(colors::RESOURCE, "Applying patch {}", project_relative_path.string()));
 
 		// delete potential previous dependency report
@@ -49,6 +54,9 @@ namespace callisto {
 		rom_file.read(reinterpret_cast<char*>(rom_bytes.data()), unheadered_rom_size);
 		rom_file.close();
 
+		// kept around so we can record what the patch overwrote and undo it during later updates
+		const std::vector<char> rom_before_patch(rom_bytes.begin(), rom_bytes.begin() + unheadered_rom_size);
+
 		spdlog::debug(fmt::format(
 			"Applying patch {} to temporary ROM {}:\n\r"
 			"\tROM size:\t\t{}\n\r"
@@ -85,8 +93,12 @@ namespace callisto {
 			warn_settings.push_back(disable_deprecation);
 		}
 
+		// asar finds files relative to the patch through the include paths instead of our working directory
+		std::vector<fs::path> include_paths{ context.base_directory };
+		include_paths.insert(include_paths.end(), additional_include_paths.begin(), additional_include_paths.end());
+
 		std::vector<const char*> as_c_strs{};
-		for (const auto& path : additional_include_paths) {
+		for (const auto& path : include_paths) {
 			auto c_str{ new char[path.string().size() + 1] };
 			std::strcpy(c_str, path.string().c_str());
 			as_c_strs.push_back(c_str);
@@ -134,8 +146,6 @@ namespace callisto {
 			spdlog::info(prints[i]);
 		}
 
-		fs::current_path(prev_folder);
-
 		if (succeeded) {
 			int warning_count;
 			const auto warnings{ asar_getwarnings(&warning_count) };
@@ -150,11 +160,42 @@ namespace callisto {
 			int written_block_count;
 			const auto written_blocks{ asar_getwrittenblocks(&written_block_count) };
 
+			std::vector<std::pair<size_t, size_t>> written_ranges{};
 			for (size_t i{ 0 }; i != written_block_count; ++i) {
 				const auto& block{ written_blocks[i] };
 				if (block.pcoffset < 0x80000) {
 					hijacks.push_back({ block.pcoffset, block.numbytes });
 				}
+
+				if (block.pcoffset == 0x07FD7 && block.numbytes == 1) {
+					// ROM size byte in header, asar expanding the ROM isn't something we ever want to undo
+					continue;
+				}
+				written_ranges.push_back({ block.pcoffset, block.numbytes });
+			}
+
+			try {
+				const auto write_set{ WriteSet::capture(rom_before_patch, rom_bytes, written_ranges) };
+				if (!previous_version_in_rom) {
+					write_set.write(write_set_path);
+				}
+				else if (previous_write_set.has_value() 
+					&& previous_write_set.value().isIntact(rom_before_patch.data(), rom_before_patch.size())) {
+					write_set.withEarlier(previous_write_set.value(), rom_bytes).write(write_set_path);
+				}
+				else {
+					// we'd record the previous version's bytes as the original ones, so removing the patch couldn't undo it
+					fs::remove(write_set_path);
+					spdlog::debug("Bytes from before the previous version of patch {} are unknown, not recording its writes", 
+						project_relative_path.string());
+				}
+			}
+			catch (const std::exception& e) {
+				// not fatal, the next update will just have to fall back to rebuilding if it needs this
+				std::error_code ec;
+				fs::remove(write_set_path, ec);
+				spdlog::warn(fmt::format(colors::WARNING, "Failed to record bytes written by patch {}:\n\r{}", 
+					project_relative_path.string(), e.what()));
 			}
 
 			spdlog::info(fmt::format(colors::PARTIAL_SUCCESS, "Successfully applied patch {}!", project_relative_path.string()));
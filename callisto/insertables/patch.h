@@ -11,11 +11,14 @@
 #include <asar/warnings.h>
 
 #include "rom_insertable.h"
+#include "write_set.h"
 #include "../insertion_exception.h"
 #include "../not_found_exception.h"
 
 #include "../configuration/configuration.h"
 #include "../dependency/policy.h"
+#include "../path_util.h"
+#include "../execution_context.h"
 
 namespace fs = std::filesystem;
 
@@ -26,7 +29,11 @@ namespace callisto {
 
 		const fs::path patch_path;
 		std::vector<fs::path> additional_include_paths;
+		const ExecutionContext context;
 		std::vector<std::pair<size_t, size_t>> hijacks{};
+		const fs::path write_set_path;
+		bool previous_version_in_rom{ false };
+		std::optional<WriteSet> previous_write_set{};
 
 		bool disable_deprecation_warnings;
 
@@ -42,6 +49,11 @@ namespace callisto {
 		Patch(const Configuration& config,
 			const fs::path& patch_path, const std::vector<fs::path>& additional_include_paths = {});
 
+		// Call if the previous version of this patch is still in the ROM, i.e. it couldn't be rolled back, 
+		// the recorded write set then keeps what was there before the previous version, 
+		// if that isn't known no write set is recorded and removing the patch later needs a rebuild
+		void setPreviousWriteSet(const std::optional<WriteSet>& previous_write_set);
+
 		void insert() override;
 	};
 }
@@ -22,18 +22,15 @@ namespace callisto {
 		));
 
 		const auto temp_map16{ getTemporaryMap16FilePath() };
-		const auto current_path{ fs::current_path() };
 
 		try {
 			HumanReadableMap16::to_map16::convert(map16_folder_path, temp_map16);
 		}
 		catch (HumanMap16Exception& e) {
-			fs::current_path(current_path);
 			throw InsertionException(fmt::format(colors::EXCEPTION, "Failed to convert map16 folder to file with following exception:\n\r{}",
 				e.get_detailed_error_message()));
 		}
 
-		fs::current_path(current_path);
 		return temp_map16;
 	}
 
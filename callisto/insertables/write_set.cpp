@@ -0,0 +1,166 @@
+#include "write_set.h"
+
+namespace callisto {
+	WriteSet WriteSet::capture(const std::vector<char>& before, const std::vector<char>& after,
+		const std::vector<std::pair<size_t, size_t>>& written_ranges) {
+		WriteSet write_set{};
+
+		for (const auto& [pc_offset, size] : written_ranges) {
+			Range range{ pc_offset, std::vector<char>(size, 0), std::vector<char>(size, 0) };
+
+			if (pc_offset < before.size()) {
+				const auto available{ std::min(size, before.size() - pc_offset) };
+				std::copy(before.begin() + pc_offset, before.begin() + pc_offset + available, range.pre_image.begin());
+			}
+
+			if (pc_offset < after.size()) {
+				const auto available{ std::min(size, after.size() - pc_offset) };
+				std::copy(after.begin() + pc_offset, after.begin() + pc_offset + available, range.post_image.begin());
+			}
+
+			write_set.ranges.push_back(std::move(range));
+		}
+
+		return write_set;
+	}
+
+	WriteSet WriteSet::withEarlier(const WriteSet& earlier, const std::vector<char>& after) const {
+		// the earliest pre-image of every byte wins, emplace leaves bytes already seen alone
+		std::map<size_t, char> pre_images{};
+		for (const auto* write_set : { &earlier, this }) {
+			for (const auto& range : write_set->ranges) {
+				for (size_t i{ 0 }; i != range.pre_image.size(); ++i) {
+					pre_images.emplace(range.pc_offset + i, range.pre_image[i]);
+				}
+			}
+		}
+
+		WriteSet combined{};
+		for (const auto& [pc_offset, pre_image] : pre_images) {
+			if (combined.ranges.empty() 
+				|| combined.ranges.back().pc_offset + combined.ranges.back().pre_image.size() != pc_offset) {
+				combined.ranges.push_back({ pc_offset });
+			}
+			auto& range{ combined.ranges.back() };
+			range.pre_image.push_back(pre_image);
+			range.post_image.push_back(pc_offset < after.size() ? after[pc_offset] : 0);
+		}
+
+		return combined;
+	}
+
+	std::optional<WriteSet> WriteSet::read(const fs::path& path) {
+		std::ifstream file{ path, std::ios::in | std::ios::binary };
+		if (!file) {
+			return {};
+		}
+
+		WriteSet write_set{};
+		while (true) {
+			uint32_t pc_offset;
+			uint32_t size;
+			if (!file.read(reinterpret_cast<char*>(&pc_offset), sizeof(pc_offset))) {
+				break;
+			}
+			if (!file.read(reinterpret_cast<char*>(&size), sizeof(size))) {
+				return {};
+			}
+
+			Range range{ pc_offset, std::vector<char>(size), std::vector<char>(size) };
+			if (!file.read(range.pre_image.data(), size) || !file.read(range.post_image.data(), size)) {
+				return {};
+			}
+
+			write_set.ranges.push_back(std::move(range));
+		}
+
+		return write_set;
+	}
+
+	void WriteSet::write(const fs::path& path) const {
+		fs::create_directories(path.parent_path());
+
+		std::ofstream file{ path, std::ios::out | std::ios::binary };
+		for (const auto& range : ranges) {
+			const auto pc_offset{ static_cast<uint32_t>(range.pc_offset) };
+			const auto size{ static_cast<uint32_t>(range.pre_image.size()) };
+			file.write(reinterpret_cast<const char*>(&pc_offset), sizeof(pc_offset));
+			file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+			file.write(range.pre_image.data(), size);
+			file.write(range.post_image.data(), size);
+		}
+	}
+
+	bool WriteSet::isIntact(const char* rom, size_t rom_size) const {
+		return std::all_of(ranges.begin(), ranges.end(), [&](const Range& range) {
+			return range.pc_offset + range.post_image.size() <= rom_size
+				&& std::equal(range.post_image.begin(), range.post_image.end(), rom + range.pc_offset);
+		});
+	}
+
+	void WriteSet::rollBack(char* rom, size_t rom_size) const {
+		// undo in reverse in case the same bytes were written more than once
+		for (auto range{ ranges.rbegin() }; range != ranges.rend(); ++range) {
+			if (range->pc_offset + range->pre_image.size() <= rom_size) {
+				std::copy(range->pre_image.begin(), range->pre_image.end(), rom + range->pc_offset);
+			}
+		}
+	}
+
+	bool WriteSet::overlaps(const std::vector<std::pair<size_t, size_t>>& other_ranges) const {
+		return std::any_of(ranges.begin(), ranges.end(), [&](const Range& range) {
+			return std::any_of(other_ranges.begin(), other_ranges.end(), [&](const auto& other) {
+				return range.pc_offset < other.first + other.second && other.first < range.pc_offset + range.pre_image.size();
+			});
+		});
+	}
+
+	bool WriteSet::overlaps(const WriteSet& other) const {
+		std::vector<std::pair<size_t, size_t>> other_ranges{};
+		for (const auto& range : other.ranges) {
+			other_ranges.emplace_back(range.pc_offset, range.pre_image.size());
+		}
+		return overlaps(other_ranges);
+	}
+
+	bool WriteSet::hasFreespace() const {
+		return std::any_of(ranges.begin(), ranges.end(), [](const Range& range) {
+			return range.pc_offset >= FREESPACE_START;
+		});
+	}
+
+	bool WriteSet::containsPcOffset(size_t pc_offset, bool freespace_only) const {
+		return std::any_of(ranges.begin(), ranges.end(), [&](const Range& range) {
+			return (!freespace_only || range.pc_offset >= FREESPACE_START)
+				&& range.pc_offset <= pc_offset && pc_offset < range.pc_offset + range.pre_image.size();
+		});
+	}
+
+	bool WriteSet::isReferencedFrom(const char* data, size_t size, bool jumps_only) const {
+		if (!hasFreespace()) {
+			return false;
+		}
+
+		const auto bytes{ reinterpret_cast<const unsigned char*>(data) };
+		const size_t operand_offset{ jumps_only ? 1u : 0u };
+		for (size_t i{ 0 }; i + operand_offset + 3 <= size; ++i) {
+			if (jumps_only && bytes[i] != JSL_OPCODE && bytes[i] != JML_OPCODE) {
+				continue;
+			}
+
+			const auto operand{ bytes + i + operand_offset };
+			const auto snes_address{ static_cast<size_t>(operand[0]) | (static_cast<size_t>(operand[1]) << 8)
+				| (static_cast<size_t>(operand[2]) << 16) };
+			const auto bank{ snes_address >> 16 };
+			if ((snes_address & 0x8000) == 0 || bank == 0x7E || bank == 0x7F) {
+				continue;
+			}
+
+			if (containsPcOffset(((snes_address & 0x7F0000) >> 1) | (snes_address & 0x7FFF), true)) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
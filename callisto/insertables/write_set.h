@@ -0,0 +1,57 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <map>
+
+namespace fs = std::filesystem;
+
+namespace callisto {
+	// Bytes an insertable wrote to the ROM alongside what was there before, so the write can be undone later
+	class WriteSet {
+	protected:
+		// everything a patch writes past the original 512KB of the ROM is freespace
+		static constexpr size_t FREESPACE_START{ 0x80000 };
+		static constexpr unsigned char JSL_OPCODE{ 0x22 };
+		static constexpr unsigned char JML_OPCODE{ 0x5C };
+
+		bool containsPcOffset(size_t pc_offset, bool freespace_only) const;
+
+	public:
+		struct Range {
+			size_t pc_offset;
+			std::vector<char> pre_image;
+			std::vector<char> post_image;
+		};
+
+		std::vector<Range> ranges{};
+
+		// before must contain the unheadered ROM prior to the write, after the unheadered ROM following it,
+		// anything past the end of before is treated as zeroes since that's what ROM expansion fills in
+		static WriteSet capture(const std::vector<char>& before, const std::vector<char>& after,
+			const std::vector<std::pair<size_t, size_t>>& written_ranges);
+
+		// Combines this write set with earlier's when the insertion that recorded earlier was still in the ROM this one was
+		// captured from, so rolling back restores the bytes from before either, after must be the ROM following this write
+		WriteSet withEarlier(const WriteSet& earlier, const std::vector<char>& after) const;
+
+		static std::optional<WriteSet> read(const fs::path& path);
+		void write(const fs::path& path) const;
+
+		// Whether the given unheadered ROM still contains exactly the bytes we wrote, i.e. nobody wrote over them since
+		bool isIntact(const char* rom, size_t rom_size) const;
+		void rollBack(char* rom, size_t rom_size) const;
+
+		bool overlaps(const std::vector<std::pair<size_t, size_t>>& other_ranges) const;
+		bool overlaps(const WriteSet& other) const;
+
+		bool hasFreespace() const;
+		// Whether data holds a long (LoROM) pointer into freespace we wrote, with jumps_only set only JSL/JML 
+		// operands count, which is what hooks look like and keeps random data from matching too easily
+		bool isReferencedFrom(const char* data, size_t size, bool jumps_only) const;
+	};
+}
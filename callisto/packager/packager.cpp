@@ -0,0 +1,138 @@
+#include "packager.h"
+
+namespace callisto {
+	fs::path Packager::getRecordPath(const fs::path& project_root, const fs::path& package) {
+		// named after the package's location, so different profiles' packages get different records
+		return PathUtil::getPackageRecordDirectoryPath(project_root) 
+			/ (HashUtil::hashString(fs::absolute(package).lexically_normal().string()) + ".json");
+	}
+
+	std::optional<Packager::Record> Packager::readRecord(const fs::path& record_path) {
+		if (!fs::exists(record_path)) {
+			return {};
+		}
+
+		try {
+			std::ifstream file{ record_path };
+			const auto j{ json::parse(file) };
+
+			if (j.value("version", 0) != RECORD_VERSION) {
+				return {};
+			}
+
+			return Record{
+				j["clean_rom"].get<std::string>(),
+				j["output_rom"].get<std::string>(),
+				j["package"].get<std::string>(),
+				j["effort"].get<std::string>()
+			};
+		}
+		catch (const json::exception& e) {
+			spdlog::debug("Failed to read package record at {}, ignoring it: {}", record_path.string(), e.what());
+			return {};
+		}
+	}
+
+	void Packager::writeRecord(const fs::path& record_path, const Record& record) {
+		json j;
+		j["version"] = RECORD_VERSION;
+		j["clean_rom"] = record.clean_rom_hash;
+		j["output_rom"] = record.output_rom_hash;
+		j["package"] = record.package_hash;
+		j["effort"] = record.effort;
+
+		fs::create_directories(record_path.parent_path());
+		std::ofstream file{ record_path };
+		file << std::setw(4) << j << std::endl;
+	}
+
+	Packager::Result Packager::packageOne(const Configuration& config, const CleanRom& clean_rom) {
+		const auto output_rom_path{ config.output_rom.getOrThrow() };
+		const auto package_path{ config.bps_package.getOrThrow() };
+		const auto effort{ config.bps_effort.getOrDefault("balanced") };
+
+		if (!fs::exists(output_rom_path)) {
+			throw PackagingException(fmt::format(
+				colors::EXCEPTION,
+				"No ROM found at {}, cannot package it",
+				output_rom_path.string()
+			));
+		}
+
+		const auto output_rom{ FileUtil::readAll(output_rom_path) };
+		const auto record_path{ getRecordPath(config.project_root.getOrThrow(), package_path) };
+		Record record{ clean_rom.hash, HashUtil::toHexString(HashUtil::xxh64(output_rom.data(), output_rom.size())), {}, effort };
+
+		const auto previous_record{ readRecord(record_path) };
+		if (previous_record.has_value() && fs::exists(package_path)) {
+			record.package_hash = previous_record->package_hash;
+			// the package itself is checked too, in case somebody replaced or edited it since
+			if (record == *previous_record && HashUtil::hashFile(package_path) == record.package_hash) {
+				spdlog::debug("Package {} is up to date with {}, keeping it", package_path.string(), output_rom_path.string());
+				return { output_rom_path, package_path, true };
+			}
+		}
+
+		spdlog::debug("Creating package {} from {}", package_path.string(), output_rom_path.string());
+		const auto patch{ Bps::create(clean_rom.bytes, output_rom, Bps::parseEffort(effort)) };
+
+		if (package_path.has_parent_path()) {
+			fs::create_directories(package_path.parent_path());
+		}
+		const std::string_view patch_view{ patch.data(), patch.size() };
+		FileUtil::writeAtomically(patch_view, package_path);
+
+		record.package_hash = HashUtil::hashString(patch_view);
+		writeRecord(record_path, record);
+
+		return { output_rom_path, package_path, false };
+	}
+
+	std::vector<Packager::Result> Packager::package(const std::vector<std::shared_ptr<Configuration>>& configs) {
+		std::map<fs::path, std::string> package_owners{};
+		std::map<fs::path, CleanRom> clean_roms{};
+
+		for (const auto& config : configs) {
+			const auto package_path{ fs::absolute(config->bps_package.getOrThrow()).lexically_normal() };
+			const auto output_rom_path{ config->output_rom.getOrThrow().string() };
+			const auto [owner, inserted] { package_owners.emplace(package_path, output_rom_path) };
+			if (!inserted) {
+				throw PackagingException(fmt::format(
+					colors::EXCEPTION,
+					"Cannot package both {} and {} to {}",
+					owner->second, output_rom_path, package_path.string()
+				));
+			}
+
+			const auto clean_rom_path{ fs::absolute(config->clean_rom.getOrThrow()).lexically_normal() };
+			if (clean_roms.contains(clean_rom_path)) {
+				continue;
+			}
+
+			if (!fs::exists(clean_rom_path)) {
+				throw NotFoundException(fmt::format(
+					colors::EXCEPTION,
+					"Clean ROM not found at {}",
+					clean_rom_path.string()
+				));
+			}
+
+			auto bytes{ FileUtil::readAll(clean_rom_path) };
+			auto hash{ HashUtil::toHexString(HashUtil::xxh64(bytes.data(), bytes.size())) };
+			clean_roms.emplace(clean_rom_path, CleanRom{ std::move(bytes), std::move(hash) });
+		}
+
+		std::vector<std::optional<Result>> results(configs.size());
+		Scheduler::forEach(configs.size(), [&](size_t i) {
+			const auto& config{ *configs[i] };
+			const auto& clean_rom{ clean_roms.at(fs::absolute(config.clean_rom.getOrThrow()).lexically_normal()) };
+			results[i] = packageOne(config, clean_rom);
+		});
+
+		std::vector<Result> package_results{};
+		for (auto& result : results) {
+			package_results.push_back(std::move(*result));
+		}
+		return package_results;
+	}
+}
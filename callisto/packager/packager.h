@@ -0,0 +1,73 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include "../configuration/configuration.h"
+#include "../bps/bps.h"
+#include "../callisto_exception.h"
+#include "../not_found_exception.h"
+#include "../file_util.h"
+#include "../hash_util.h"
+#include "../path_util.h"
+#include "../colors.h"
+#include "../scheduler.h"
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace callisto {
+	class PackagingException : public CallistoException {
+	public:
+		using CallistoException::CallistoException;
+	};
+
+	// Turns output ROMs into BPS packages, remembering what each package was made from so 
+	// packaging an unchanged ROM again just keeps the package that's already there
+	class Packager {
+	public:
+		struct Result {
+			fs::path output_rom;
+			fs::path package;
+			// whether the existing package was kept because nothing it depends on changed
+			bool reused;
+		};
+
+	protected:
+		static constexpr auto RECORD_VERSION{ 1 };
+
+		struct Record {
+			std::string clean_rom_hash;
+			std::string output_rom_hash;
+			std::string package_hash;
+			std::string effort;
+
+			bool operator==(const Record&) const = default;
+		};
+
+		struct CleanRom {
+			std::vector<char> bytes;
+			std::string hash;
+		};
+
+		static fs::path getRecordPath(const fs::path& project_root, const fs::path& package);
+		static std::optional<Record> readRecord(const fs::path& record_path);
+		static void writeRecord(const fs::path& record_path, const Record& record);
+
+		static Result packageOne(const Configuration& config, const CleanRom& clean_rom);
+
+	public:
+		// Packages the output ROM of every passed configuration in parallel, every distinct clean ROM is only read once,
+		// throws the first failure once the packages already being created are done
+		static std::vector<Result> package(const std::vector<std::shared_ptr<Configuration>>& configs);
+	};
+}
@@ -21,8 +21,19 @@ namespace callisto {
 		static constexpr auto MODULES_OLD_DIRECTORY_NAME{ "old" };
 		static constexpr auto MODULES_CURRENT_DIRECTORY_NAME{ "current" };
 
+		static constexpr auto PATCHED_ROMS_DIRECTORY_NAME{ "patched_roms" };
+		static constexpr auto PACKAGES_DIRECTORY_NAME{ "packages" };
+		static constexpr auto EXPANDED_CLEAN_ROM_NAME{ "expanded_clean_rom" };
+
+		static constexpr auto WRITE_SETS_DIRECTORY_NAME{ "write_sets" };
+		static constexpr auto WRITE_SET_SUFFIX{ ".writes" };
+
 		static constexpr auto BUILD_REPORT_FILE_NAME{ "build_report.json" };
 		static constexpr auto LAST_ROM_SYNC_TIME_FILE_NAME{ "last_rom_sync.json" };
+		static constexpr auto LEVEL_HASHES_FILE_NAME{ "level_hashes.json" };
+		static constexpr auto MWL_INDEX_FILE_NAME{ "mwl_index.json" };
+		static constexpr auto CLEAN_ROM_GRAPHICS_FILE_NAME{ "clean_rom_graphics.json" };
+		static constexpr auto GRAPHICS_MANIFEST_FILE_NAME{ "graphics_manifest.json" };
 		static constexpr auto ASSEMBLY_INFO_FILE{ "callisto.asm" };
 		static constexpr auto USER_SETTINGS_FOLDER_NAME{ "callisto" };
 		static constexpr auto RECENT_PROJECTS_FILE{ "recent_projects.json" };
@@ -38,6 +49,13 @@ namespace callisto {
 			return fs::absolute(fs::weakly_canonical(relative_to / path));
 		}
 
+		// Whether path is directory itself or anywhere below it, purely lexically after making both absolute
+		static bool isWithin(const fs::path& path, const fs::path& directory) {
+			const auto relative{ fs::weakly_canonical(fs::absolute(path))
+				.lexically_relative(fs::weakly_canonical(fs::absolute(directory))) };
+			return !relative.empty() && *relative.begin() != "..";
+		}
+
 		static fs::path sanitizeForAsar(const fs::path& path) {
 			auto as_string{ path.string() };
 			boost::replace_all(as_string, "!", "\\!");
@@ -74,6 +92,22 @@ namespace callisto {
 			return getCallistoCachePath(project_root) / LAST_ROM_SYNC_TIME_FILE_NAME;
 		}
 
+		static fs::path getLevelHashesPath(const fs::path& project_root) {
+			return getCallistoCachePath(project_root) / LEVEL_HASHES_FILE_NAME;
+		}
+
+		static fs::path getMwlIndexPath(const fs::path& project_root) {
+			return getCallistoCachePath(project_root) / MWL_INDEX_FILE_NAME;
+		}
+
+		static fs::path getCleanRomGraphicsPath(const fs::path& project_root) {
+			return getCallistoCachePath(project_root) / CLEAN_ROM_GRAPHICS_FILE_NAME;
+		}
+
+		static fs::path getGraphicsManifestPath(const fs::path& project_root) {
+			return getCallistoCachePath(project_root) / GRAPHICS_MANIFEST_FILE_NAME;
+		}
+
 		static fs::path getModuleCacheDirectoryPath(const fs::path& project_root) {
 			return getCallistoCachePath(project_root) / MODULES_DIRECTORY_NAME;
 		}
@@ -90,6 +124,26 @@ namespace callisto {
 			return getModuleCacheDirectoryPath(project_root) / MODULES_CLEANUP_CACHE_DIRECTORY_NAME;
 		}
 
+		static fs::path getPatchedRomCacheDirectoryPath(const fs::path& project_root) {
+			return getCallistoCachePath(project_root) / PATCHED_ROMS_DIRECTORY_NAME;
+		}
+
+		static fs::path getExpandedCleanRomPath(const fs::path& project_root, const fs::path& clean_rom_extension) {
+			return getCallistoCachePath(project_root) / (EXPANDED_CLEAN_ROM_NAME + clean_rom_extension.string());
+		}
+
+		static fs::path getPackageRecordDirectoryPath(const fs::path& project_root) {
+			return getCallistoCachePath(project_root) / PACKAGES_DIRECTORY_NAME;
+		}
+
+		static fs::path getWriteSetDirectoryPath(const fs::path& project_root) {
+			return getCallistoCachePath(project_root) / WRITE_SETS_DIRECTORY_NAME;
+		}
+
+		static fs::path getPatchWriteSetPath(const fs::path& project_root, const fs::path& project_relative_patch_path) {
+			return getWriteSetDirectoryPath(project_root) / (project_relative_patch_path.string() + WRITE_SET_SUFFIX);
+		}
+
 		static fs::path getUserModuleDirectoryPath(const fs::path& project_root) {
 			return getCallistoDirectoryPath(project_root) / MODULES_DIRECTORY_NAME;
 		}
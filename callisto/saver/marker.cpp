@@ -73,17 +73,16 @@ namespace callisto {
 
 		asar_reset();
 
-		const auto prev_diretcory{ fs::current_path() };
-		fs::current_path(boost::filesystem::temp_directory_path().string());
-
+		// asar only needs the patch to have a path, making it absolute keeps it from depending on our working directory
+		const auto memory_patch_path{ (fs::temp_directory_path() / "extractor.asm").string() };
 		memoryfile patch;
-		patch.path = "extractor.asm";
+		patch.path = memory_patch_path.c_str();
 		patch.buffer = patch_string.data();
 		patch.length = patch_string.size();
 
 		const patchparams params{
 			sizeof(struct patchparams),
-			"extractor.asm",
+			memory_patch_path.c_str(),
 			rom_bytes.data() + header_size,
 			MAX_ROM_SIZE,
 			&unheadered_rom_size,
@@ -103,8 +102,6 @@ namespace callisto {
 		};
 
 		const bool succeeded{ asar_patch_ex(&params) };
-
-		fs::current_path(prev_diretcory);
 		
 		if (succeeded) {
 			int print_count;
@@ -153,17 +150,15 @@ namespace callisto {
 
 		asar_reset();
 
-		const auto prev_directory{ fs::current_path() };
-		fs::current_path(boost::filesystem::temp_directory_path().string());
-
+		const auto memory_patch_path{ (fs::temp_directory_path() / "inserter.asm").string() };
 		memoryfile patch;
-		patch.path = "inserter.asm";
+		patch.path = memory_patch_path.c_str();
 		patch.buffer = patch_string.data();
 		patch.length = patch_string.size();
 
 		const patchparams params{
 			sizeof(struct patchparams),
-			"inserter.asm",
+			memory_patch_path.c_str(),
 			rom_bytes.data() + header_size,
 			MAX_ROM_SIZE,
 			&unheadered_rom_size,
@@ -184,8 +179,6 @@ namespace callisto {
 
 		const bool succeeded{ asar_patch_ex(&params) };
 
-		fs::current_path(prev_directory);
-
 		if (succeeded) {
 			spdlog::debug("Successfully inserted marker string into ROM {}", rom_path.string());
 
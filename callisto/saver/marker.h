@@ -9,7 +9,6 @@
 #include <spdlog/spdlog.h>
 #include <fmt/format.h>
 #include <asar-dll-bindings/c/asardll.h>
-#include <boost/filesystem.hpp>
 #include <nlohmann/json.hpp>
 
 #include "extractable_type.h"
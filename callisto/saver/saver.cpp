@@ -190,17 +190,34 @@ namespace callisto {
 			fs::copy(config.output_rom.getOrThrow(), temporary_rom_path, fs::copy_options::overwrite_existing);
 			const auto extractables{ getExtractables(config, need_extraction, rom_path) };
 
+			// extractables don't depend on each other, the expensive ones are started first, one failing 
+			// doesn't stop the others so everything that can be exported still is
 			std::exception_ptr thread_exception{};
-			std::for_each(std::execution::par, extractables.begin(), extractables.end(), [&](auto&& extractable) {
-				spdlog::info("");
-				try {
-					extractable->extract();
-				}
-				catch (...) {
-					thread_exception = std::current_exception();
-				}
-				spdlog::info("");
-			});
+			std::mutex exception_mutex{};
+			TaskGraph export_graph{};
+			for (size_t i{ 0 }; i != extractables.size(); ++i) {
+				export_graph.add("export " + Descriptor(extractable_to_symbol.at(need_extraction[i])).toString(config.project_root.getOrThrow()), 
+					[&, extractable = extractables[i]] {
+					spdlog::info("");
+					try {
+						extractable->extract();
+					}
+					catch (...) {
+						std::scoped_lock lock(exception_mutex);
+						if (thread_exception == nullptr) {
+							thread_exception = std::current_exception();
+						}
+					}
+					spdlog::info("");
+				}, {}, extractables[i]->getCost());
+			}
+
+			try {
+				export_graph.run();
+			}
+			catch (...) {
+				thread_exception = std::current_exception();
+			}
 
 			if (thread_exception != nullptr) {
 				try {
@@ -213,6 +230,11 @@ namespace callisto {
 				std::rethrow_exception(thread_exception);
 			}
 
+			size_t changed_files{ 0 };
+			for (const auto& extractable : extractables) {
+				changed_files += extractable->getChangedFileCount();
+			}
+
 			if (mark) {
 				const auto potential_build_report{ PathUtil::getBuildReportPath(config.project_root.getOrThrow()) };
 
@@ -246,11 +268,72 @@ namespace callisto {
 
 			const auto export_end{ std::chrono::high_resolution_clock::now() };
 
-			spdlog::info(fmt::format(colors::SUCCESS, "All resources exported successfully in {}!",
-				TimeUtil::getDurationString(export_end - export_start)));
+			spdlog::info(fmt::format(colors::SUCCESS, "All resources exported successfully in {}, {} file{} changed!",
+				TimeUtil::getDurationString(export_end - export_start), changed_files, changed_files == 1 ? "" : "s"));
 		}
 		else {
 			spdlog::info(fmt::format(colors::NOTIFICATION, "All resources already up to date, nothing for me to export -.-"));
 		}
 	}
+
+	void Saver::exportLevels(const fs::path& rom_path, const Configuration& config, const std::vector<int>& level_numbers) {
+		if (!config.levels.isSet()) {
+			throw CallistoException(fmt::format(colors::EXCEPTION, "{} not set in configuration, cannot export levels", config.levels.name));
+		}
+
+		spdlog::info(fmt::format(colors::ACTION_START, "Exporting {} level{}", level_numbers.size(), level_numbers.size() == 1 ? "" : "s"));
+		const auto export_start{ std::chrono::high_resolution_clock::now() };
+
+		const auto& levels_folder{ config.levels.getOrThrow() };
+		size_t changed_files{ 0 };
+		try {
+			for (const auto level_number : level_numbers) {
+				spdlog::info("");
+				Level level{ config, levels_folder / fmt::format("level {:03X}.mwl", level_number), level_number, rom_path };
+				level.extract();
+				changed_files += level.getChangedFileCount();
+			}
+			spdlog::info("");
+
+			Levels(config, rom_path, globals::MAX_THREAD_COUNT).recordExported(level_numbers);
+		}
+		catch (...) {
+			try {
+				fs::remove_all(config.temporary_folder.getOrThrow());
+			}
+			catch (const std::runtime_error&) {
+				spdlog::warn(fmt::format(colors::WARNING, "Failed to remove temporary folder '{}'",
+					config.temporary_folder.getOrThrow().string()));
+			}
+			throw;
+		}
+
+		const auto potential_build_report{ PathUtil::getBuildReportPath(config.project_root.getOrThrow()) };
+		if (fs::exists(potential_build_report)) {
+			spdlog::info(fmt::format(colors::CALLISTO, "Found a build report, updating it now"));
+			try {
+				updateBuildReport(potential_build_report, { ExtractableType::LEVELS });
+				spdlog::info(fmt::format(colors::PARTIAL_SUCCESS, "Successfully updated build report!\n"));
+			}
+			catch (const std::exception& e) {
+				spdlog::warn(fmt::format(colors::WARNING, "Failed to update build report with exception:\n\r{}", e.what()));
+			}
+		}
+
+		// the export marker says the whole ROM is synced with the project, which we can't know from a few levels, 
+		// anything else edited since the last full save still has to show up as unsaved
+		spdlog::info(fmt::format(colors::NOTIFICATION, "Only levels were exported, export marker left as is"));
+
+		try {
+			fs::remove_all(config.temporary_folder.getOrThrow());
+		}
+		catch (const std::runtime_error&) {
+			spdlog::warn(fmt::format(colors::WARNING, "Failed to remove temporary folder '{}'",
+				config.temporary_folder.getOrThrow().string()));
+		}
+
+		const auto export_end{ std::chrono::high_resolution_clock::now() };
+		spdlog::info(fmt::format(colors::SUCCESS, "Level{} exported successfully in {}, {} file{} changed!", level_numbers.size() == 1 ? "" : "s",
+			TimeUtil::getDurationString(export_end - export_start), changed_files, changed_files == 1 ? "" : "s"));
+	}
 }
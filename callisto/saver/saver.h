@@ -24,6 +24,7 @@
 #include "../extractables/text_map16.h"
 #include "../extractables/title_screen.h"
 #include "../extractables/levels.h"
+#include "../extractables/level.h"
 #include "../extractables/graphics.h"
 #include "../extractables/exgraphics.h"
 
@@ -35,6 +36,7 @@
 #include "../time_util.h"
 #include "../colors.h"
 #include "../globals.h"
+#include "../task_graph.h"
 
 namespace fs = std::filesystem;
 using json = nlohmann::json;
@@ -54,5 +56,7 @@ namespace callisto {
 		static std::vector<ExtractableType> getExtractableTypes(const Configuration& config);
 		static void writeMarkerToRom(const fs::path& rom_path, const Configuration& config);
 		static void exportResources(const fs::path& rom_path, const Configuration& config, bool force = false, bool mark = true);
+		// Exports only the passed levels, the export marker isn't touched since other resources may still be unsaved
+		static void exportLevels(const fs::path& rom_path, const Configuration& config, const std::vector<int>& level_numbers);
 	};
 }
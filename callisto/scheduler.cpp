@@ -0,0 +1,103 @@
+#include "scheduler.h"
+
+namespace callisto {
+	Scheduler::CallerScope::CallerScope() {
+		if (counted_here) {
+			std::unique_lock lock(budget_mutex);
+			budget_returned.wait(lock, [] { return busy_threads < std::max<size_t>(1, globals::MAX_THREAD_COUNT); });
+			++busy_threads;
+			is_busy = true;
+		}
+	}
+
+	Scheduler::CallerScope::~CallerScope() {
+		if (counted_here) {
+			{
+				std::scoped_lock lock(budget_mutex);
+				--busy_threads;
+				is_busy = false;
+			}
+			budget_returned.notify_all();
+		}
+	}
+
+	bool Scheduler::tryBorrowThread() {
+		std::scoped_lock lock(budget_mutex);
+		if (busy_threads >= globals::MAX_THREAD_COUNT) {
+			return false;
+		}
+		++busy_threads;
+		return true;
+	}
+
+	void Scheduler::startBorrowedThread() {
+		is_busy = true;
+	}
+
+	void Scheduler::returnThread() {
+		{
+			std::scoped_lock lock(budget_mutex);
+			--busy_threads;
+		}
+		budget_returned.notify_all();
+	}
+
+	void Scheduler::forEach(size_t task_count, const std::function<void(size_t)>& task) {
+		const CallerScope caller{};
+		std::atomic<size_t> next_task{ 0 };
+		std::mutex state_mutex{};
+		std::condition_variable helpers_done{};
+		size_t active_helpers{ 0 };
+		std::vector<std::jthread> helpers{};
+		std::exception_ptr task_exception{};
+
+		std::function<void()> work;
+		const auto borrowHelperIfUseful{ [&] {
+			// threads are borrowed as work gets picked up rather than all at once, 
+			// so work that starts while the budget is exhausted still speeds up once other work finishes
+			if (next_task < task_count && tryBorrowThread()) {
+				std::scoped_lock lock(state_mutex);
+				++active_helpers;
+				helpers.emplace_back([&] {
+					startBorrowedThread();
+					work();
+					returnThread();
+					std::scoped_lock helper_lock(state_mutex);
+					--active_helpers;
+					helpers_done.notify_all();
+				});
+			}
+		} };
+
+		work = [&] {
+			size_t task_idx;
+			while ((task_idx = next_task++) < task_count) {
+				borrowHelperIfUseful();
+				try {
+					task(task_idx);
+				}
+				catch (...) {
+					std::scoped_lock lock(state_mutex);
+					if (task_exception == nullptr) {
+						task_exception = std::current_exception();
+					}
+					next_task = task_count;
+				}
+			}
+		};
+
+		work();
+
+		{
+			std::unique_lock lock(state_mutex);
+			helpers_done.wait(lock, [&] { return active_helpers == 0; });
+		}
+		for (auto& helper : helpers) {
+			helper.join();
+		}
+
+		if (task_exception != nullptr) {
+			std::rethrow_exception(task_exception);
+		}
+	}
+}
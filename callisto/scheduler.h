@@ -0,0 +1,62 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <exception>
+#include <algorithm>
+
+#include "globals.h"
+
+namespace callisto {
+	// Hands out the globals::MAX_THREAD_COUNT threads we're allowed to use to all parallel work, including the threads 
+	// that call in, nested parallel work only gets threads that nobody else is using, so the total number of busy threads
+	// (and with that the number of Lunar Magic processes they wait on) never exceeds the budget
+	class Scheduler {
+		friend class TaskGraph;
+
+	protected:
+		inline static std::mutex budget_mutex{};
+		inline static std::condition_variable budget_returned{};
+		// callers of forEach and TaskGraph::run plus the threads borrowed to help them
+		inline static size_t busy_threads{ 0 };
+		// set on threads that are already part of busy_threads, so nested calls don't count them twice
+		inline static thread_local bool is_busy{ false };
+
+		// Counts the calling thread as busy until it goes out of scope, unless it already is, threads that aren't busy yet 
+		// wait for the budget here, busy ones never wait, so nested calls can't deadlock
+		class CallerScope {
+		protected:
+			const bool counted_here{ !is_busy };
+
+		public:
+			CallerScope();
+			~CallerScope();
+		};
+
+		static bool tryBorrowThread();
+		// Must be called first thing on a borrowed thread
+		static void startBorrowedThread();
+		static void returnThread();
+
+	public:
+		// Runs task for every index below task_count, lower indices are started first, so put expensive tasks up front,
+		// the calling thread works on the tasks itself and is joined by borrowed threads while there are any to spare,
+		// only calls from outside of parallel work can wait for the budget, nested calls start right away, 
+		// once a task throws no new tasks are started and the exception is rethrown after the running ones are done
+		static void forEach(size_t task_count, const std::function<void(size_t)>& task);
+
+		template<typename T, typename Function>
+		static void forEach(std::vector<T>& elements, Function&& function) {
+			forEach(elements.size(), [&](size_t i) { function(elements[i]); });
+		}
+
+		template<typename T, typename Function>
+		static void forEach(const std::vector<T>& elements, Function&& function) {
+			forEach(elements.size(), [&](size_t i) { function(elements[i]); });
+		}
+	};
+}
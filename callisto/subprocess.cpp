@@ -0,0 +1,274 @@
+#include "subprocess.h"
+
+namespace callisto {
+	void Subprocess::Group::OutputTail::append(const char* data, size_t count) {
+		// only the last buffer.size() bytes can survive anyway
+		if (count > buffer.size()) {
+			data += count - buffer.size();
+			count = buffer.size();
+		}
+
+		for (size_t i{ 0 }; i != count; ++i) {
+			buffer[(start + size) % buffer.size()] = data[i];
+			if (size == buffer.size()) {
+				start = (start + 1) % buffer.size();
+			}
+			else {
+				++size;
+			}
+		}
+	}
+
+	std::string Subprocess::Group::OutputTail::contents() const {
+		std::string contents{};
+		contents.reserve(size);
+		for (size_t i{ 0 }; i != size; ++i) {
+			contents.push_back(buffer[(start + i) % buffer.size()]);
+		}
+		return contents;
+	}
+
+	bp::environment Subprocess::getEnvironment(const Options& options) {
+		bp::environment environment{ boost::this_process::environment() };
+		for (const auto& [name, value] : options.environment) {
+			environment[name] = value;
+		}
+		return environment;
+	}
+
+	template<typename... Command>
+	size_t Subprocess::Group::launch(const std::string& description, const Options& options, Command&&... command) {
+		auto child{ std::make_unique<Child>(io_context, description, options) };
+		const auto working_directory{ options.working_directory.value_or(fs::current_path()).string() };
+		const auto environment{ getEnvironment(options) };
+
+		try {
+			if (options.take_user_input) {
+				// interactive programs get our console as is, some only prompt when their output goes to one
+				child->process = bp::child(std::forward<Command>(command)..., bp::start_dir(working_directory), environment,
+					bp::std_in < stdin, bp::std_out > stdout, bp::std_err > stderr);
+			}
+			else {
+				child->process = bp::child(std::forward<Command>(command)..., bp::start_dir(working_directory), environment,
+					bp::std_in < bp::null, bp::std_out > child->output.pipe, bp::std_err > child->error_output.pipe);
+			}
+		}
+		catch (const bp::process_error& e) {
+			throw SubprocessException(fmt::format(
+				colors::EXCEPTION,
+				"Failed to start {}: {}",
+				description,
+				e.what()
+			));
+		}
+
+		// we reap the process ourselves in poll(), so boost shouldn't touch it anymore
+		child->process.detach();
+		child->start_time = std::chrono::steady_clock::now();
+
+		// nobody can tell how long a person will take to answer, so only the global timeout skips interactive programs
+		const auto timeout{ options.timeout.has_value() || options.take_user_input ? options.timeout : globals::PROCESS_TIMEOUT };
+		if (timeout.has_value()) {
+			child->deadline = child->start_time + timeout.value();
+		}
+
+		spdlog::debug("Started {} with pid {}", description, child->process.id());
+
+		if (options.take_user_input) {
+			for (auto stream : { &child->output, &child->error_output }) {
+				boost::system::error_code ignored;
+				stream->pipe.close(ignored);
+				stream->open = false;
+			}
+		}
+		else {
+			read(child->output);
+			read(child->error_output);
+		}
+		children.push_back(std::move(child));
+		return children.size() - 1;
+	}
+
+	size_t Subprocess::Group::start(const fs::path& executable, const std::vector<std::string>& args, const Options& options) {
+		return launch(executable.filename().string(), options, bp::exe(executable.string()), bp::args(args));
+	}
+
+	size_t Subprocess::Group::startCommandLine(const std::string& command_line, const Options& options) {
+		return launch(command_line, options, command_line);
+	}
+
+	void Subprocess::Group::read(Stream& stream) {
+		stream.pipe.async_read_some(boost::asio::buffer(stream.chunk),
+			[this, &stream](const boost::system::error_code& ec, size_t count) {
+			if (count != 0) {
+				stream.tail.append(stream.chunk.data(), count);
+				if (stream.echo_target != nullptr) {
+					std::fwrite(stream.chunk.data(), 1, count, stream.echo_target);
+					std::fflush(stream.echo_target);
+				}
+			}
+
+			if (ec) {
+				// end of file, or we closed the pipe ourselves
+				stream.open = false;
+				boost::system::error_code ignored;
+				stream.pipe.close(ignored);
+				return;
+			}
+
+			read(stream);
+		});
+	}
+
+	void Subprocess::Group::poll() {
+		const auto now{ std::chrono::steady_clock::now() };
+		bool pending{ false };
+
+		for (auto& child : children) {
+			if (!child->exit_time.has_value()) {
+				if (reap(*child)) {
+					child->exit_time = now;
+					child->result.wall_time = std::chrono::duration_cast<std::chrono::milliseconds>(now - child->start_time);
+					spdlog::debug("{} exited with code {} after {}ms", child->description,
+						child->result.exit_code, child->result.wall_time.count());
+				}
+				else if (!child->stopped && cancel_requested) {
+					spdlog::debug("Stopping {} since it was cancelled", child->description);
+					child->result.cancelled = true;
+					child->stopped = true;
+					kill(*child);
+				}
+				else if (!child->stopped && child->deadline.has_value() && now >= child->deadline.value()) {
+					spdlog::error(fmt::format(
+						colors::EXCEPTION,
+						"{} did not finish within {} seconds and was stopped",
+						child->description,
+						std::chrono::duration_cast<std::chrono::seconds>(child->deadline.value() - child->start_time).count()
+					));
+					child->result.timed_out = true;
+					child->stopped = true;
+					kill(*child);
+				}
+			}
+
+			if (child->exit_time.has_value() && now - child->exit_time.value() >= EXIT_DRAIN_TIME) {
+				// closing makes pending reads complete with an error, which marks the streams as closed
+				for (auto stream : { &child->output, &child->error_output }) {
+					if (stream->pipe.is_open()) {
+						boost::system::error_code ignored;
+						stream->pipe.close(ignored);
+					}
+				}
+			}
+
+			pending = pending || !child->done();
+		}
+
+		if (pending) {
+			poll_timer.expires_after(POLL_INTERVAL);
+			poll_timer.async_wait([this](const boost::system::error_code& ec) {
+				if (!ec) {
+					poll();
+				}
+			});
+		}
+	}
+
+	bool Subprocess::Group::reap(Child& child) {
+#ifdef _WIN32
+		const auto handle{ child.process.native_handle() };
+		if (WaitForSingleObject(handle, 0) != WAIT_OBJECT_0) {
+			return false;
+		}
+
+		DWORD exit_code{};
+		if (GetExitCodeProcess(handle, &exit_code)) {
+			child.result.exit_code = static_cast<int>(exit_code);
+		}
+
+		FILETIME creation_time, exit_time, kernel_time, user_time;
+		if (GetProcessTimes(handle, &creation_time, &exit_time, &kernel_time, &user_time)) {
+			const auto toTicks{ [](const FILETIME& time) {
+				return (static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+			} };
+			// FILETIME counts in 100ns steps
+			child.result.cpu_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+				std::chrono::nanoseconds((toTicks(kernel_time) + toTicks(user_time)) * 100));
+		}
+		return true;
+#else
+		int status{ 0 };
+		rusage usage{};
+		const auto pid{ child.process.id() };
+		const auto reaped{ wait4(pid, &status, WNOHANG, &usage) };
+		if (reaped == 0) {
+			return false;
+		}
+
+		// anything but our pid means somebody else reaped it already, so all we know is that it's gone
+		if (reaped == pid) {
+			child.result.exit_code = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+			child.result.cpu_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+				std::chrono::seconds(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec)
+				+ std::chrono::microseconds(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec));
+		}
+		return true;
+#endif
+	}
+
+	void Subprocess::Group::kill(Child& child) {
+#ifdef _WIN32
+		TerminateProcess(child.process.native_handle(), EXIT_FAILURE);
+#else
+		::kill(child.process.id(), SIGKILL);
+#endif
+	}
+
+	std::vector<Subprocess::Result> Subprocess::Group::wait() {
+		poll();
+		io_context.run();
+		io_context.restart();
+
+		std::vector<Result> results{};
+		for (auto& child : children) {
+			child->result.output = child->output.tail.contents();
+			child->result.error_output = child->error_output.tail.contents();
+			results.push_back(std::move(child->result));
+		}
+		children.clear();
+		cancel_requested = false;
+
+		return results;
+	}
+
+	void Subprocess::Group::cancel() {
+		cancel_requested = true;
+	}
+
+	Subprocess::Result Subprocess::run(const fs::path& executable, const std::vector<std::string>& args, const Options& options) {
+		Group group{};
+		group.start(executable, args, options);
+		return std::move(group.wait().front());
+	}
+
+	Subprocess::Result Subprocess::runCommandLine(const std::string& command_line, const Options& options) {
+		Group group{};
+		group.startCommandLine(command_line, options);
+		return std::move(group.wait().front());
+	}
+
+	void Subprocess::launchDetached(const std::string& command_line, const Options& options) {
+		const auto working_directory{ options.working_directory.value_or(fs::current_path()).string() };
+		try {
+			bp::spawn(command_line, bp::start_dir(working_directory), getEnvironment(options));
+		}
+		catch (const bp::process_error& e) {
+			throw SubprocessException(fmt::format(
+				colors::EXCEPTION,
+				"Failed to start {}: {}",
+				command_line,
+				e.what()
+			));
+		}
+	}
+}
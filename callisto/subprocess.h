@@ -0,0 +1,174 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <boost/asio.hpp>
+#include <boost/process.hpp>
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
+
+#include "callisto_exception.h"
+#include "colors.h"
+#include "globals.h"
+
+namespace fs = std::filesystem;
+namespace bp = boost::process;
+
+namespace callisto {
+	class SubprocessException : public CallistoException {
+	public:
+		using CallistoException::CallistoException;
+	};
+
+	struct SubprocessOptions {
+		// defaults to our own working directory
+		std::optional<fs::path> working_directory{};
+		// set on top of the environment we were started with
+		std::map<std::string, std::string> environment{};
+		// defaults to globals::PROCESS_TIMEOUT unless the program takes user input, no timeout if neither is set
+		std::optional<std::chrono::seconds> timeout{};
+		// whether the program gets our stdin, stdout and stderr, its output isn't captured then, 
+		// otherwise it reads from an empty stream
+		bool take_user_input{ false };
+		// whether captured output is forwarded to our stdout/stderr as it arrives
+		bool echo_output{ true };
+	};
+
+	struct SubprocessResult {
+		int exit_code{ -1 };
+		bool timed_out{ false };
+		bool cancelled{ false };
+		// the last Subprocess::OUTPUT_TAIL_SIZE bytes the program wrote to stdout/stderr, empty for programs taking user input
+		std::string output{};
+		std::string error_output{};
+		std::chrono::milliseconds wall_time{};
+		std::chrono::milliseconds cpu_time{};
+
+		bool succeeded() const {
+			return exit_code == 0 && !timed_out && !cancelled;
+		}
+	};
+
+	// Runs external programs (Lunar Magic, FLIPS, generic tools, emulators) with their output captured
+	// and a deadline after which they're stopped, so a hung program can't stall the build forever
+	class Subprocess {
+	protected:
+		// our own environment with the variables from options added
+		static bp::environment getEnvironment(const SubprocessOptions& options);
+
+	public:
+		using Options = SubprocessOptions;
+		using Result = SubprocessResult;
+
+		static constexpr size_t OUTPUT_TAIL_SIZE{ 1 << 16 };
+
+		// Starts any number of programs and waits for all of them on the calling thread
+		class Group {
+		protected:
+			static constexpr std::chrono::milliseconds POLL_INTERVAL{ 10 };
+			// how long we keep reading a program's output after it exited, in case
+			// something it started is still holding on to its pipes
+			static constexpr std::chrono::milliseconds EXIT_DRAIN_TIME{ 500 };
+
+			// keeps the last bytes appended to it, so a chatty program can't use up all our memory
+			class OutputTail {
+			protected:
+				std::vector<char> buffer;
+				size_t start{ 0 };
+				size_t size{ 0 };
+
+			public:
+				OutputTail() : buffer(OUTPUT_TAIL_SIZE) {}
+
+				void append(const char* data, size_t count);
+				std::string contents() const;
+			};
+
+			struct Stream {
+				bp::async_pipe pipe;
+				std::array<char, 4096> chunk{};
+				OutputTail tail{};
+				FILE* const echo_target;
+				bool open{ true };
+
+				Stream(boost::asio::io_context& io_context, FILE* echo_target)
+					: pipe(io_context), echo_target(echo_target) {}
+			};
+
+			struct Child {
+				const std::string description;
+				const Options options;
+				Stream output;
+				Stream error_output;
+				bp::child process{};
+				std::chrono::steady_clock::time_point start_time{};
+				std::optional<std::chrono::steady_clock::time_point> deadline{};
+				std::optional<std::chrono::steady_clock::time_point> exit_time{};
+				bool stopped{ false };
+				Result result{};
+
+				Child(boost::asio::io_context& io_context, const std::string& description, const Options& options)
+					: description(description), options(options),
+					output(io_context, options.echo_output ? stdout : nullptr),
+					error_output(io_context, options.echo_output ? stderr : nullptr) {}
+
+				bool done() const {
+					return exit_time.has_value() && !output.open && !error_output.open;
+				}
+			};
+
+			boost::asio::io_context io_context{};
+			boost::asio::steady_timer poll_timer{ io_context };
+			std::vector<std::unique_ptr<Child>> children{};
+			std::atomic<bool> cancel_requested{ false };
+
+			template<typename... Command>
+			size_t launch(const std::string& description, const Options& options, Command&&... command);
+
+			void read(Stream& stream);
+			void poll();
+			// returns whether the child has exited, filling in its exit code and CPU time if so
+			static bool reap(Child& child);
+			static void kill(Child& child);
+
+		public:
+			// Runs executable with args passed as separate arguments, returns the index of its result in wait()
+			size_t start(const fs::path& executable, const std::vector<std::string>& args, const Options& options = {});
+			// Runs a whole command line, for user supplied options that we can't split into arguments ourselves
+			size_t startCommandLine(const std::string& command_line, const Options& options = {});
+
+			// Waits until every started program is done, results are in the order the programs were started
+			std::vector<Result> wait();
+
+			// Stops every program in this group, can be called from any thread
+			void cancel();
+		};
+
+		static Result run(const fs::path& executable, const std::vector<std::string>& args, const Options& options = {});
+		static Result runCommandLine(const std::string& command_line, const Options& options = {});
+
+		// Starts a program we don't wait for or capture anything from, like an emulator
+		static void launchDetached(const std::string& command_line, const Options& options = {});
+	};
+}
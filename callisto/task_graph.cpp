@@ -0,0 +1,155 @@
+#include "task_graph.h"
+
+namespace callisto {
+	TaskGraph::TaskId TaskGraph::add(std::string name, std::function<void()> function, 
+		const std::vector<TaskId>& dependencies, size_t priority) {
+		const auto task_id{ tasks.size() };
+		Task task{ std::move(name), std::move(function), priority };
+
+		for (const auto dependency : dependencies) {
+			if (dependency >= task_id) {
+				throw std::invalid_argument("Tasks can only depend on tasks added before them");
+			}
+			tasks[dependency].dependents.push_back(task_id);
+			++task.unfinished_dependencies;
+		}
+
+		tasks.push_back(std::move(task));
+		return task_id;
+	}
+
+	bool TaskGraph::isHigherPriority(TaskId a, TaskId b) const {
+		if (tasks[a].priority != tasks[b].priority) {
+			return tasks[a].priority > tasks[b].priority;
+		}
+		return a < b;
+	}
+
+	void TaskGraph::pushReady(TaskId task_id) {
+		tasks[task_id].ready_time = Clock::now();
+		ready_tasks.push_back(task_id);
+		std::push_heap(ready_tasks.begin(), ready_tasks.end(), [&](TaskId a, TaskId b) { return isHigherPriority(b, a); });
+	}
+
+	TaskGraph::TaskId TaskGraph::popReady() {
+		std::pop_heap(ready_tasks.begin(), ready_tasks.end(), [&](TaskId a, TaskId b) { return isHigherPriority(b, a); });
+		const auto task_id{ ready_tasks.back() };
+		ready_tasks.pop_back();
+		return task_id;
+	}
+
+	void TaskGraph::borrowHelperIfUseful() {
+		// called with state_mutex held
+		if (!ready_tasks.empty() && Scheduler::tryBorrowThread()) {
+			++active_helpers;
+			helpers.emplace_back([this] {
+				Scheduler::startBorrowedThread();
+				work(true);
+				Scheduler::returnThread();
+				std::scoped_lock lock(state_mutex);
+				--active_helpers;
+				state_changed.notify_all();
+			});
+		}
+	}
+
+	void TaskGraph::runTask(TaskId task_id) {
+		auto& task{ tasks[task_id] };
+		const auto start{ Clock::now() };
+		try {
+			task.function();
+		}
+		catch (...) {
+			std::scoped_lock lock(state_mutex);
+			if (task_exception == nullptr) {
+				task_exception = std::current_exception();
+			}
+			cancel_requested = true;
+		}
+		task.run_time = Clock::now() - start;
+
+		spdlog::debug("Task '{}' took {}ms after waiting {}ms to be picked up", task.name,
+			std::chrono::duration_cast<std::chrono::milliseconds>(task.run_time).count(),
+			std::chrono::duration_cast<std::chrono::milliseconds>(start - task.ready_time).count());
+	}
+
+	void TaskGraph::work(bool is_helper) {
+		std::unique_lock lock(state_mutex);
+		while (true) {
+			if (!is_helper) {
+				// the calling thread stays until everything is done, helpers leave when they run out of work
+				state_changed.wait(lock, [&] {
+					return !ready_tasks.empty() || unfinished_tasks == 0 || (cancel_requested && running_tasks == 0);
+				});
+			}
+
+			if (cancel_requested || ready_tasks.empty()) {
+				return;
+			}
+
+			const auto task_id{ popReady() };
+			++running_tasks;
+			borrowHelperIfUseful();
+
+			lock.unlock();
+			runTask(task_id);
+			lock.lock();
+
+			--running_tasks;
+			--unfinished_tasks;
+			for (const auto dependent : tasks[task_id].dependents) {
+				if (--tasks[dependent].unfinished_dependencies == 0) {
+					pushReady(dependent);
+				}
+			}
+			state_changed.notify_all();
+		}
+	}
+
+	void TaskGraph::run() {
+		const Scheduler::CallerScope caller{};
+		const auto start{ Clock::now() };
+		{
+			std::scoped_lock lock(state_mutex);
+			unfinished_tasks = tasks.size();
+			for (TaskId task_id{ 0 }; task_id != tasks.size(); ++task_id) {
+				if (tasks[task_id].unfinished_dependencies == 0) {
+					pushReady(task_id);
+				}
+			}
+		}
+
+		work(false);
+
+		{
+			std::unique_lock lock(state_mutex);
+			state_changed.wait(lock, [&] { return active_helpers == 0; });
+		}
+		for (auto& helper : helpers) {
+			helper.join();
+		}
+		helpers.clear();
+
+		if (task_exception != nullptr) {
+			std::rethrow_exception(task_exception);
+		}
+
+		if (cancel_requested) {
+			spdlog::debug("Task graph was cancelled with {} of {} tasks unfinished", unfinished_tasks, tasks.size());
+		}
+		else {
+			spdlog::debug("Ran {} tasks in {}ms", tasks.size(),
+				std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count());
+		}
+	}
+
+	void TaskGraph::cancel() {
+		std::scoped_lock lock(state_mutex);
+		cancel_requested = true;
+		state_changed.notify_all();
+	}
+
+	bool TaskGraph::cancelled() const {
+		return cancel_requested;
+	}
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <exception>
+#include <stdexcept>
+#include <algorithm>
+
+#include <spdlog/spdlog.h>
+
+#include "scheduler.h"
+
+namespace callisto {
+	// Runs tasks once everything they depend on has finished, independent tasks run in parallel within 
+	// the thread budget of the Scheduler, which nested Scheduler::forEach calls inside tasks also draw from
+	class TaskGraph {
+	public:
+		using TaskId = size_t;
+
+	protected:
+		using Clock = std::chrono::high_resolution_clock;
+
+		struct Task {
+			std::string name;
+			std::function<void()> function;
+			size_t priority;
+			std::vector<TaskId> dependents{};
+			size_t unfinished_dependencies{ 0 };
+			Clock::time_point ready_time{};
+			Clock::duration run_time{};
+		};
+
+		std::vector<Task> tasks{};
+
+		std::mutex state_mutex{};
+		std::condition_variable state_changed{};
+		// kept as a heap ordered by priority, ties go to the task that was added first
+		std::vector<TaskId> ready_tasks{};
+		size_t unfinished_tasks{ 0 };
+		size_t running_tasks{ 0 };
+		size_t active_helpers{ 0 };
+		std::vector<std::jthread> helpers{};
+		std::exception_ptr task_exception{};
+		std::atomic<bool> cancel_requested{ false };
+
+		bool isHigherPriority(TaskId a, TaskId b) const;
+		void pushReady(TaskId task_id);
+		TaskId popReady();
+
+		void work(bool is_helper);
+		void runTask(TaskId task_id);
+		void borrowHelperIfUseful();
+
+	public:
+		// Dependencies must have been added before, so the graph can't contain cycles, 
+		// ready tasks with higher priority are started first
+		TaskId add(std::string name, std::function<void()> function, const std::vector<TaskId>& dependencies = {}, size_t priority = 0);
+
+		// Runs all tasks using the calling thread and borrowed ones, once a task throws or cancel() is called 
+		// no further tasks are started, the first exception is rethrown after the running tasks are done
+		void run();
+
+		// Tasks that run for a while can check cancelled() to stop early
+		void cancel();
+		bool cancelled() const;
+	};
+}
@@ -0,0 +1,85 @@
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "../bps/bps.h"
+#include "bps_test_data.h"
+
+namespace fs = std::filesystem;
+
+using namespace callisto;
+
+namespace {
+	constexpr size_t REPETITIONS{ 5 };
+
+	// best of REPETITIONS runs in seconds, the best run is the one least disturbed by everything else on the machine
+	template<typename F>
+	double timeBest(F&& function) {
+		double best{ std::numeric_limits<double>::max() };
+		for (size_t i{ 0 }; i != REPETITIONS; ++i) {
+			const auto start{ std::chrono::steady_clock::now() };
+			function();
+			const std::chrono::duration<double> elapsed{ std::chrono::steady_clock::now() - start };
+			best = std::min(best, elapsed.count());
+		}
+		return best;
+	}
+
+	double megabytesPerSecond(size_t bytes, double seconds) {
+		return static_cast<double>(bytes) / (1024.0 * 1024.0) / seconds;
+	}
+
+	std::string effortName(Bps::Effort effort) {
+		switch (effort) {
+		case Bps::Effort::FAST:
+			return "fast";
+		case Bps::Effort::BALANCED:
+			return "balanced";
+		default:
+			return "small";
+		}
+	}
+
+	void benchmarkPair(const std::string& name, const std::vector<char>& source, const std::vector<char>& target,
+		const std::vector<char>* flips_patch) {
+		fmt::print("{} ({:#x} -> {:#x} bytes)\n", name, source.size(), target.size());
+
+		if (flips_patch != nullptr) {
+			const auto seconds{ timeBest([&] { Bps::apply(*flips_patch, source); }) };
+			fmt::print("  FLIPS patch:    {:>9} bytes, apply {:>8.2f} ms ({:.0f} MB/s)\n",
+				flips_patch->size(), seconds * 1000.0, megabytesPerSecond(target.size(), seconds));
+		}
+
+		for (const auto effort : { Bps::Effort::FAST, Bps::Effort::BALANCED, Bps::Effort::SMALL }) {
+			std::vector<char> patch{};
+			const auto create_seconds{ timeBest([&] { patch = Bps::create(source, target, effort); }) };
+			const auto apply_seconds{ timeBest([&] { Bps::apply(patch, source); }) };
+			fmt::print("  {:<15} {:>9} bytes, create {:>8.2f} ms, apply {:>8.2f} ms ({:.0f} MB/s)\n",
+				effortName(effort) + ':', patch.size(), create_seconds * 1000.0, apply_seconds * 1000.0,
+				megabytesPerSecond(target.size(), apply_seconds));
+		}
+	}
+}
+
+// Usage: bps_benchmark [clean SMW ROM], with a clean ROM the FLIPS patches in initial_patches are
+// applied to it and the results are used as targets, so our patch sizes can be compared to FLIPS'
+int main(int argc, char** argv) {
+	const auto synthetic{ test::makeRomPair(0x80000, 0x400000, 1) };
+	benchmarkPair("synthetic", synthetic.source, synthetic.target, nullptr);
+
+	if (argc > 1) {
+		const auto clean_rom{ FileUtil::readAll(argv[1]) };
+		for (const auto& entry : fs::recursive_directory_iterator(CALLISTO_INITIAL_PATCHES_DIR)) {
+			if (entry.path().extension() == ".bps") {
+				const auto flips_patch{ FileUtil::readAll(entry.path()) };
+				const auto target{ Bps::apply(flips_patch, clean_rom).target };
+				benchmarkPair(fs::relative(entry.path(), CALLISTO_INITIAL_PATCHES_DIR).string(), clean_rom, target, &flips_patch);
+			}
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,230 @@
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "../bps/bps.h"
+#include "bps_test_data.h"
+
+namespace fs = std::filesystem;
+
+namespace callisto {
+	namespace {
+		// source "ABCDEFGH" to target "ABCDxyGHGHGH" using a SourceRead, TargetRead, SourceCopy and an overlapping
+		// TargetCopy, written by hand from the format description with CRC32s from zlib
+		const std::vector<char> HAND_BUILT_PATCH{
+			0x42, 0x50, 0x53, 0x31, char(0x88), char(0x8C), char(0x80), char(0x8C), char(0x85), 0x78, 0x79,
+			char(0x86), char(0x8C), char(0x8F), char(0x8C), 0x1C, char(0xB6), char(0xDC), 0x68, 0x6B, char(0xE9),
+			0x2A, 0x6B, 0x54, 0x3D, 0x5B, 0x65
+		};
+		const std::string HAND_BUILT_SOURCE{ "ABCDEFGH" };
+		const std::string HAND_BUILT_TARGET{ "ABCDxyGHGHGH" };
+
+		std::vector<char> toBytes(const std::string& string) {
+			return std::vector<char>(string.begin(), string.end());
+		}
+
+		void writeFile(const fs::path& path, const std::vector<char>& bytes) {
+			std::ofstream file{ path, std::ios::out | std::ios::binary };
+			file.write(bytes.data(), bytes.size());
+		}
+
+		fs::path makeScratchFolder(const std::string& name) {
+			const auto folder{ fs::temp_directory_path() / ("callisto_" + name) };
+			fs::remove_all(folder);
+			fs::create_directories(folder);
+			return folder;
+		}
+
+		int runFlips(const fs::path& flips, const std::string& args) {
+			const auto command{ fmt::format("\"{}\" {}", flips.string(), args) };
+#ifdef _WIN32
+			// cmd strips the outer quotes, so the quoted executable path survives
+			return std::system(fmt::format("\"{}\"", command).c_str());
+#else
+			return std::system(command.c_str());
+#endif
+		}
+	}
+
+	TEST(BpsApply, HandBuiltPatchUsesEveryAction) {
+		const auto result{ Bps::apply(HAND_BUILT_PATCH, toBytes(HAND_BUILT_SOURCE)) };
+		EXPECT_EQ(std::string(result.target.begin(), result.target.end()), HAND_BUILT_TARGET);
+
+		// "EF" became "xy", "GH" stayed and "GHGH" was appended
+		const std::vector<std::pair<size_t, size_t>> expected_ranges{ { 4, 2 }, { 8, 4 } };
+		EXPECT_EQ(result.changed_ranges, expected_ranges);
+	}
+
+	TEST(BpsApply, KeepsCopierHeader) {
+		auto source{ std::vector<char>(512, 0x55) };
+		const auto unheadered{ toBytes(HAND_BUILT_SOURCE) };
+		source.insert(source.end(), unheadered.begin(), unheadered.end());
+
+		const auto result{ Bps::apply(HAND_BUILT_PATCH, source) };
+		ASSERT_EQ(result.target.size(), 512 + HAND_BUILT_TARGET.size());
+		EXPECT_TRUE(std::all_of(result.target.begin(), result.target.begin() + 512, [](char byte) { return byte == 0x55; }));
+		EXPECT_EQ(std::string(result.target.begin() + 512, result.target.end()), HAND_BUILT_TARGET);
+		EXPECT_EQ(result.changed_ranges.front().first, 512 + 4);
+	}
+
+	TEST(BpsApply, RejectsWrongSource) {
+		EXPECT_THROW(Bps::apply(HAND_BUILT_PATCH, toBytes("ABCDEFGX")), BpsException);
+		EXPECT_THROW(Bps::apply(HAND_BUILT_PATCH, toBytes("ABCDEFG")), BpsException);
+	}
+
+	TEST(BpsApply, RejectsCorruptedPatch) {
+		auto patch{ HAND_BUILT_PATCH };
+		patch[9] = 'z';
+		EXPECT_THROW(Bps::apply(patch, toBytes(HAND_BUILT_SOURCE)), BpsException);
+
+		EXPECT_THROW(Bps::apply(std::vector<char>(HAND_BUILT_PATCH.begin(), HAND_BUILT_PATCH.begin() + 10), 
+			toBytes(HAND_BUILT_SOURCE)), BpsException);
+	}
+
+	TEST(BpsApply, RoundTripsRomLikeData) {
+		for (const auto& [source_size, target_size] : { std::pair<size_t, size_t>{ 0x80000, 0x200000 }, { 0x100000, 0x100000 },
+			{ 0x100000, 0x80000 } }) {
+			const auto pair{ test::makeRomPair(source_size, target_size, static_cast<uint32_t>(source_size ^ target_size)) };
+			for (const auto effort : { Bps::Effort::FAST, Bps::Effort::BALANCED, Bps::Effort::SMALL }) {
+				const auto patch{ Bps::create(pair.source, pair.target, effort) };
+				EXPECT_EQ(Bps::apply(patch, pair.source).target, pair.target);
+			}
+		}
+	}
+
+	// The initial patches shipped with callisto were made with FLIPS from a clean SMW ROM, 
+	// applying them checks the result against the target CRC32 FLIPS recorded
+	TEST(BpsApply, AppliesShippedFlipsPatches) {
+		const auto clean_rom_path{ test::pathFromEnvironment("CALLISTO_TEST_CLEAN_ROM") };
+		if (!clean_rom_path.has_value()) {
+			GTEST_SKIP() << "Set CALLISTO_TEST_CLEAN_ROM to a clean SMW ROM to apply the shipped FLIPS patches";
+		}
+
+		const auto clean_rom{ FileUtil::readAll(clean_rom_path.value()) };
+		size_t applied{ 0 };
+		for (const auto& entry : fs::recursive_directory_iterator(CALLISTO_INITIAL_PATCHES_DIR)) {
+			if (entry.path().extension() == ".bps") {
+				SCOPED_TRACE(entry.path().string());
+				const auto result{ Bps::apply(FileUtil::readAll(entry.path()), clean_rom) };
+				EXPECT_EQ(result.target.size(), (clean_rom.size() % 0x8000) + 0x400000);
+				++applied;
+			}
+		}
+		EXPECT_NE(applied, 0);
+	}
+
+	TEST(BpsApply, AppliesPatchesCreatedByFlips) {
+		const auto flips{ test::pathFromEnvironment("CALLISTO_TEST_FLIPS") };
+		if (!flips.has_value()) {
+			GTEST_SKIP() << "Set CALLISTO_TEST_FLIPS to a FLIPS executable to test against patches it creates";
+		}
+
+		const auto folder{ makeScratchFolder("bps_apply_flips") };
+		const auto pair{ test::makeRomPair(0x80000, 0x200000, 1) };
+		writeFile(folder / "source.sfc", pair.source);
+		writeFile(folder / "target.sfc", pair.target);
+
+		ASSERT_EQ(runFlips(flips.value(), fmt::format("--create --bps-delta \"{}\" \"{}\" \"{}\"", 
+			(folder / "source.sfc").string(), (folder / "target.sfc").string(), (folder / "flips.bps").string())), 0);
+		EXPECT_EQ(Bps::apply(FileUtil::readAll(folder / "flips.bps"), pair.source).target, pair.target);
+
+		fs::remove_all(folder);
+	}
+}
+
+namespace callisto {
+	namespace {
+		class ThreadCountOverride {
+		protected:
+			const size_t previous{ globals::MAX_THREAD_COUNT };
+
+		public:
+			ThreadCountOverride(size_t thread_count) {
+				globals::MAX_THREAD_COUNT = thread_count;
+			}
+
+			~ThreadCountOverride() {
+				globals::MAX_THREAD_COUNT = previous;
+			}
+		};
+
+		// loose bound, FLIPS looks at every candidate while we cap them per effort
+		constexpr double MAX_SIZE_RATIO_TO_FLIPS{ 1.5 };
+	}
+
+	TEST(BpsCreate, PatchDoesNotDependOnThreadCount) {
+		const auto pair{ test::makeRomPair(0x80000, 0x400000, 2) };
+		for (const auto effort : { Bps::Effort::FAST, Bps::Effort::BALANCED, Bps::Effort::SMALL }) {
+			std::vector<char> single_threaded{};
+			{
+				ThreadCountOverride thread_count{ 1 };
+				single_threaded = Bps::create(pair.source, pair.target, effort);
+			}
+			ThreadCountOverride thread_count{ 16 };
+			EXPECT_EQ(Bps::create(pair.source, pair.target, effort), single_threaded);
+		}
+	}
+
+	TEST(BpsCreate, UnchangedRomGivesTinyPatch) {
+		const auto pair{ test::makeRomPair(0x80000, 0x80000, 3) };
+		const auto patch{ Bps::create(pair.source, pair.source, Bps::Effort::FAST) };
+		EXPECT_LT(patch.size(), 64);
+		EXPECT_EQ(Bps::apply(patch, pair.source).target, pair.source);
+	}
+
+	TEST(BpsCreate, MoreEffortDoesNotGrowPatches) {
+		const auto pair{ test::makeRomPair(0x80000, 0x200000, 4) };
+		const auto fast{ Bps::create(pair.source, pair.target, Bps::Effort::FAST) };
+		const auto small{ Bps::create(pair.source, pair.target, Bps::Effort::SMALL) };
+		EXPECT_LE(small.size(), fast.size());
+	}
+
+	// Recreates the shipped initial patches from the ROMs FLIPS made them from and compares sizes
+	TEST(BpsCreate, StaysCloseToFlipsOnShippedPatches) {
+		const auto clean_rom_path{ test::pathFromEnvironment("CALLISTO_TEST_CLEAN_ROM") };
+		if (!clean_rom_path.has_value()) {
+			GTEST_SKIP() << "Set CALLISTO_TEST_CLEAN_ROM to a clean SMW ROM to compare against the shipped FLIPS patches";
+		}
+
+		const auto clean_rom{ FileUtil::readAll(clean_rom_path.value()) };
+		for (const auto& entry : fs::recursive_directory_iterator(CALLISTO_INITIAL_PATCHES_DIR)) {
+			if (entry.path().extension() == ".bps") {
+				SCOPED_TRACE(entry.path().string());
+				const auto flips_patch{ FileUtil::readAll(entry.path()) };
+				const auto target{ Bps::apply(flips_patch, clean_rom).target };
+				const auto patch{ Bps::create(clean_rom, target, Bps::Effort::SMALL) };
+				fmt::print("{}: FLIPS {} bytes, callisto {} bytes\n", entry.path().string(), flips_patch.size(), patch.size());
+
+				EXPECT_EQ(Bps::apply(patch, clean_rom).target, target);
+				EXPECT_LE(static_cast<double>(patch.size()), flips_patch.size() * MAX_SIZE_RATIO_TO_FLIPS);
+			}
+		}
+	}
+
+	TEST(BpsCreate, StaysCloseToFlips) {
+		const auto flips{ test::pathFromEnvironment("CALLISTO_TEST_FLIPS") };
+		if (!flips.has_value()) {
+			GTEST_SKIP() << "Set CALLISTO_TEST_FLIPS to a FLIPS executable to compare patch sizes against it";
+		}
+
+		const auto folder{ makeScratchFolder("bps_create_flips") };
+		const auto pair{ test::makeRomPair(0x80000, 0x400000, 5) };
+		writeFile(folder / "source.sfc", pair.source);
+		writeFile(folder / "target.sfc", pair.target);
+
+		ASSERT_EQ(runFlips(flips.value(), fmt::format("--create --bps-delta \"{}\" \"{}\" \"{}\"",
+			(folder / "source.sfc").string(), (folder / "target.sfc").string(), (folder / "flips.bps").string())), 0);
+		const auto flips_size{ fs::file_size(folder / "flips.bps") };
+		const auto patch{ Bps::create(pair.source, pair.target, Bps::Effort::SMALL) };
+		fmt::print("FLIPS {} bytes, callisto {} bytes\n", flips_size, patch.size());
+		EXPECT_LE(static_cast<double>(patch.size()), flips_size * MAX_SIZE_RATIO_TO_FLIPS);
+
+		fs::remove_all(folder);
+	}
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace callisto {
+	namespace test {
+		struct RomPair {
+			std::vector<char> source;
+			std::vector<char> target;
+		};
+
+		// Deterministic stand-in for a ROM and an edited, expanded copy of it, the source mixes code-like 
+		// random bytes, freespace, graphics-like data with few distinct values and repeated tables, 
+		// the target patches single bytes, moves blocks around and fills the expanded area with new data 
+		// and copies of existing blocks, so every BPS action has something to do
+		inline RomPair makeRomPair(size_t source_size, size_t target_size, uint32_t seed) {
+			std::mt19937 random{ seed };
+			const auto between{ [&](size_t low, size_t high) {
+				return std::uniform_int_distribution<size_t>(low, high)(random);
+			} };
+			const auto randomByte{ [&] { return static_cast<char>(between(0, 255)); } };
+
+			RomPair pair{};
+			auto& source{ pair.source };
+			source.reserve(source_size);
+			while (source.size() < source_size) {
+				const auto length{ std::min(between(0x100, 0x2000), source_size - source.size()) };
+				switch (between(0, 3)) {
+				case 0:
+					for (size_t i{ 0 }; i != length; ++i) {
+						source.push_back(randomByte());
+					}
+					break;
+				case 1:
+					source.insert(source.end(), length, 0);
+					break;
+				case 2: {
+					const char palette[]{ 0x00, 0x0F, static_cast<char>(0xF0), static_cast<char>(0xFF) };
+					for (size_t i{ 0 }; i != length; ++i) {
+						source.push_back(palette[between(0, 3)]);
+					}
+					break;
+				}
+				default:
+					if (source.size() < length) {
+						source.insert(source.end(), length, static_cast<char>(0xFF));
+					}
+					else {
+						const auto from{ between(0, source.size() - length) };
+						for (size_t i{ 0 }; i != length; ++i) {
+							source.push_back(source[from + i]);
+						}
+					}
+				}
+			}
+
+			auto& target{ pair.target };
+			target = source;
+			target.resize(target_size, 0);
+
+			const auto edited_size{ std::min(source_size, target_size) };
+			for (size_t edit{ 0 }; edit != edited_size / 0x800; ++edit) {
+				target[between(0, edited_size - 1)] = randomByte();
+			}
+
+			for (size_t move{ 0 }; move != edited_size / 0x8000 && edited_size > 0x1000; ++move) {
+				const auto length{ between(0x100, 0x1000) };
+				const auto from{ between(0, source_size - length) };
+				const auto to{ between(0, edited_size - length) };
+				std::copy(source.begin() + from, source.begin() + from + length, target.begin() + to);
+			}
+
+			size_t position{ edited_size };
+			while (position < target_size) {
+				const auto length{ std::min(between(0x100, 0x4000), target_size - position) };
+				switch (between(0, 2)) {
+				case 0:
+					for (size_t i{ 0 }; i != length; ++i) {
+						target[position + i] = randomByte();
+					}
+					break;
+				case 1:
+					if (source_size >= length) {
+						const auto from{ between(0, source_size - length) };
+						std::copy(source.begin() + from, source.begin() + from + length, target.begin() + position);
+					}
+					break;
+				default:
+					// left as freespace
+					break;
+				}
+				position += length;
+			}
+
+			return pair;
+		}
+
+		inline std::optional<fs::path> pathFromEnvironment(const char* name) {
+			const auto value{ std::getenv(name) };
+			if (value == nullptr || std::string(value).empty()) {
+				return {};
+			}
+			return fs::path(value);
+		}
+	}
+}
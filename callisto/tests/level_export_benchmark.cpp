@@ -0,0 +1,207 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "../file_util.h"
+
+namespace fs = std::filesystem;
+
+using namespace callisto;
+
+namespace {
+	constexpr size_t REPETITIONS{ 5 };
+
+	constexpr size_t ROM_SIZE{ 0x400000 };
+	constexpr size_t LAYER_1_POINTERS_OFFSET{ 0x2E000 };
+	constexpr size_t LAYER_1_POINTER_SIZE{ 3 };
+	constexpr size_t LEVEL_COUNT{ 0x200 };
+	constexpr size_t CHUNK_COUNT{ 16 };
+	// bytes createChunkedRom writes per level it disables, the layer 1 pointer plus the layer 2 bank byte
+	constexpr size_t DISABLED_LEVEL_WRITE_SIZE{ LAYER_1_POINTER_SIZE + 1 };
+
+	constexpr size_t MWL_SIZE{ 0x2000 };
+	// where Lunar Magic puts the source addresses normalization strips, roughly
+	constexpr size_t MWL_SOURCE_ADDRESS_OFFSETS[]{ 0x44, 0x1044, 0x1844, 0x1C44 };
+
+	struct Result {
+		double seconds;
+		size_t bytes_read;
+		size_t bytes_written;
+	};
+
+	// best of REPETITIONS runs in seconds, the best run is the one least disturbed by everything else on the machine
+	template<typename F>
+	double timeBest(F&& function) {
+		double best{ std::numeric_limits<double>::max() };
+		for (size_t i{ 0 }; i != REPETITIONS; ++i) {
+			const auto start{ std::chrono::steady_clock::now() };
+			function();
+			const std::chrono::duration<double> elapsed{ std::chrono::steady_clock::now() - start };
+			best = std::min(best, elapsed.count());
+		}
+		return best;
+	}
+
+	std::vector<char> randomBytes(size_t size, unsigned int seed) {
+		std::mt19937 random{ seed };
+		std::vector<char> bytes(size);
+		for (auto& byte : bytes) {
+			byte = static_cast<char>(random() & 0xFF);
+		}
+		return bytes;
+	}
+
+	void writeFile(const fs::path& path, const std::vector<char>& bytes) {
+		std::ofstream file{ path, std::ios::out | std::ios::binary };
+		file.write(bytes.data(), bytes.size());
+	}
+
+	void disableLevels(const fs::path& rom_path, size_t chunk_idx) {
+		std::fstream rom_file(rom_path, std::ios::in | std::ios::out | std::ios::binary);
+		for (size_t level_number{ 0 }; level_number != LEVEL_COUNT; ++level_number) {
+			if (level_number % CHUNK_COUNT == chunk_idx) {
+				continue;
+			}
+			const auto pointer_offset{ LAYER_1_POINTERS_OFFSET + level_number * LAYER_1_POINTER_SIZE };
+			rom_file.seekp(pointer_offset);
+			for (size_t i{ 0 }; i != LAYER_1_POINTER_SIZE; ++i) {
+				rom_file.put(0x00);
+			}
+			rom_file.seekp(pointer_offset + 0x600 + 2);
+			rom_file.put(static_cast<char>(0xFF));
+		}
+	}
+
+	// one ROM per chunk in which every level outside the chunk is disabled, like Levels::createChunkedRom
+	Result benchmarkChunkedRoms(const fs::path& folder, bool clone) {
+		const auto rom_path{ folder / "rom.smc" };
+		writeFile(rom_path, randomBytes(ROM_SIZE, 1));
+
+		bool all_cloned{ true };
+		const auto seconds{ timeBest([&] {
+			for (size_t chunk_idx{ 0 }; chunk_idx != CHUNK_COUNT; ++chunk_idx) {
+				const auto chunk_path{ folder / fmt::format("rom_{}.smc", chunk_idx) };
+				if (clone) {
+					all_cloned = FileUtil::cloneFile(rom_path, chunk_path) && all_cloned;
+				}
+				else {
+					fs::copy_file(rom_path, chunk_path, fs::copy_options::overwrite_existing);
+					all_cloned = false;
+				}
+				disableLevels(chunk_path, chunk_idx);
+			}
+		}) };
+
+		const auto edits_per_chunk{ (LEVEL_COUNT - LEVEL_COUNT / CHUNK_COUNT) * DISABLED_LEVEL_WRITE_SIZE };
+		const auto copied_per_chunk{ all_cloned ? 0 : ROM_SIZE };
+		return { seconds, CHUNK_COUNT * copied_per_chunk, CHUNK_COUNT * (copied_per_chunk + edits_per_chunk) };
+	}
+
+	void stripSourceAddresses(std::vector<char>& mwl_bytes) {
+		for (const auto offset : MWL_SOURCE_ADDRESS_OFFSETS) {
+			std::fill_n(mwl_bytes.begin() + offset, 3, 0);
+		}
+	}
+
+	// exports land in a temporary folder, then end up in the levels folder, some of them changed since
+	// the previous export, the rest are identical to what is already there
+	Result benchmarkMovingLevels(const fs::path& folder, bool fused, size_t changed_count) {
+		const auto exported_folder{ folder / "exported" };
+		const auto levels_folder{ folder / "levels" };
+		fs::create_directories(exported_folder);
+		fs::create_directories(levels_folder);
+
+		std::vector<std::vector<char>> exports{};
+		for (size_t level_number{ 0 }; level_number != LEVEL_COUNT; ++level_number) {
+			exports.push_back(randomBytes(MWL_SIZE, static_cast<unsigned int>(level_number)));
+		}
+
+		Result result{ std::numeric_limits<double>::max(), 0, 0 };
+		for (size_t repetition{ 0 }; repetition != REPETITIONS; ++repetition) {
+			// the previous export, already normalized
+			for (size_t level_number{ 0 }; level_number != LEVEL_COUNT; ++level_number) {
+				auto previous{ exports[level_number] };
+				if (level_number < changed_count) {
+					previous[MWL_SIZE / 2] ^= 0xFF;
+				}
+				stripSourceAddresses(previous);
+				writeFile(levels_folder / fmt::format("level {:03X}.mwl", level_number), previous);
+				writeFile(exported_folder / fmt::format("level {:03X}.mwl", level_number), exports[level_number]);
+			}
+
+			size_t bytes_read{ 0 };
+			size_t bytes_written{ 0 };
+			const auto start{ std::chrono::steady_clock::now() };
+			for (size_t level_number{ 0 }; level_number != LEVEL_COUNT; ++level_number) {
+				const auto name{ fmt::format("level {:03X}.mwl", level_number) };
+				const auto exported_path{ exported_folder / name };
+				const auto target_path{ levels_folder / name };
+
+				if (fused) {
+					// Level::moveExported
+					auto mwl_bytes{ FileUtil::readAll(exported_path) };
+					stripSourceAddresses(mwl_bytes);
+					const std::string_view content{ mwl_bytes.data(), mwl_bytes.size() };
+					const auto had_content{ FileUtil::hasContent(target_path, content) };
+					bytes_read += 2 * MWL_SIZE;
+					if (!had_content) {
+						FileUtil::writeAtomically(content, target_path);
+						bytes_written += MWL_SIZE;
+					}
+					fs::remove(exported_path);
+				}
+				else {
+					// copying every export into place and normalizing it there afterwards
+					fs::copy_file(exported_path, target_path, fs::copy_options::overwrite_existing);
+					fs::remove(exported_path);
+					auto mwl_bytes{ FileUtil::readAll(target_path) };
+					stripSourceAddresses(mwl_bytes);
+					writeFile(target_path, mwl_bytes);
+					bytes_read += 2 * MWL_SIZE;
+					bytes_written += 2 * MWL_SIZE;
+				}
+			}
+			const std::chrono::duration<double> elapsed{ std::chrono::steady_clock::now() - start };
+			result = { std::min(result.seconds, elapsed.count()), bytes_read, bytes_written };
+		}
+
+		return result;
+	}
+
+	void printResult(const std::string& name, const Result& result) {
+		fmt::print("  {:<28} {:>8.2f} ms, {:>6} KB read, {:>6} KB written\n", name + ':', result.seconds * 1000.0,
+			result.bytes_read / 1024, result.bytes_written / 1024);
+	}
+}
+
+// Usage: level_export_benchmark [folder], times the file work around a level export, i.e. creating
+// the chunked ROMs for multithreaded export and moving exported MWLs into place, the Lunar Magic calls
+// themselves aren't part of it, pass a folder on a filesystem with reflinks (Btrfs, XFS, ReFS) to see
+// the effect of cloning the chunked ROMs, otherwise both variants copy
+int main(int argc, char** argv) {
+	const auto folder{ (argc > 1 ? fs::path(argv[1]) : fs::temp_directory_path()) / "callisto_level_export_benchmark" };
+	fs::remove_all(folder);
+	fs::create_directories(folder);
+
+	fmt::print("{} chunked ROMs of {:#x} bytes\n", CHUNK_COUNT, ROM_SIZE);
+	printResult("copy", benchmarkChunkedRoms(folder, false));
+	printResult("clone", benchmarkChunkedRoms(folder, true));
+
+	for (const auto changed_count : { LEVEL_COUNT, LEVEL_COUNT / 16 }) {
+		fmt::print("{} exported levels of {:#x} bytes, {} of them changed\n", LEVEL_COUNT, MWL_SIZE, changed_count);
+		printResult("copy, then normalize", benchmarkMovingLevels(folder, false, changed_count));
+		printResult("normalize while moving", benchmarkMovingLevels(folder, true, changed_count));
+	}
+
+	fs::remove_all(folder);
+
+	return 0;
+}
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../extractables/level_rom_data.h"
+
+namespace callisto {
+	namespace extractables {
+		namespace {
+			constexpr size_t ROM_SIZE{ 0x100000 };
+			constexpr int LEVEL_NUMBER{ 0x105 };
+
+			// where Lunar Magic put the level's data in the expanded area, right behind their RATS tags
+			constexpr size_t LAYER_1_DATA_OFFSET{ 0x80008 };
+			constexpr size_t LAYER_1_DATA_SIZE{ 0x20 };
+			constexpr size_t SPRITE_DATA_OFFSET{ 0x88008 };
+			constexpr size_t SPRITE_DATA_SIZE{ 0x10 };
+
+			// not level data, e.g. ExAnimation or a level's palette
+			constexpr size_t OTHER_EXPANDED_DATA_OFFSET{ 0xA0000 };
+
+			void writeRatsTag(std::vector<unsigned char>& rom, size_t data_offset, size_t data_size) {
+				const auto size_field{ data_size - 1 };
+				rom[data_offset - 8] = 'S';
+				rom[data_offset - 7] = 'T';
+				rom[data_offset - 6] = 'A';
+				rom[data_offset - 5] = 'R';
+				rom[data_offset - 4] = static_cast<unsigned char>(size_field & 0xFF);
+				rom[data_offset - 3] = static_cast<unsigned char>(size_field >> 8);
+				rom[data_offset - 2] = static_cast<unsigned char>((size_field ^ 0xFFFF) & 0xFF);
+				rom[data_offset - 1] = static_cast<unsigned char>((size_field ^ 0xFFFF) >> 8);
+			}
+
+			// a ROM in which only LEVEL_NUMBER has been saved by Lunar Magic
+			std::vector<unsigned char> makeRom() {
+				std::mt19937 random{ 1 };
+				std::vector<unsigned char> rom(ROM_SIZE, 0);
+				for (auto& byte : rom) {
+					byte = static_cast<unsigned char>(random() & 0xFF);
+				}
+
+				// every other level still points at its original data in bank $06
+				for (int level_number{ 0 }; level_number != LevelRomData::LAYER_1_POINTERS_AMOUNT; ++level_number) {
+					const auto entry{ LevelRomData::LAYER_1_POINTERS_OFFSET + level_number * LevelRomData::LAYER_1_POINTER_SIZE };
+					rom[entry] = 0x00;
+					rom[entry + 1] = 0x80;
+					rom[entry + 2] = 0x06;
+					rom[LevelRomData::SPRITE_BANK_TABLE_OFFSET + level_number] = 0x00;
+				}
+
+				const auto layer_1_entry{ LevelRomData::LAYER_1_POINTERS_OFFSET + LEVEL_NUMBER * LevelRomData::LAYER_1_POINTER_SIZE };
+				rom[layer_1_entry] = 0x08;
+				rom[layer_1_entry + 1] = 0x80;
+				rom[layer_1_entry + 2] = 0x10;
+				writeRatsTag(rom, LAYER_1_DATA_OFFSET, LAYER_1_DATA_SIZE);
+
+				const auto layer_2_entry{ LevelRomData::LAYER_2_POINTERS_OFFSET + LEVEL_NUMBER * LevelRomData::LAYER_2_POINTER_SIZE };
+				rom[layer_2_entry] = 0x00;
+				rom[layer_2_entry + 1] = 0x80;
+				rom[layer_2_entry + 2] = LevelRomData::BACKGROUND_BANK;
+
+				const auto sprite_entry{ LevelRomData::SPRITE_POINTERS_OFFSET + LEVEL_NUMBER * LevelRomData::SPRITE_POINTER_SIZE };
+				rom[sprite_entry] = 0x08;
+				rom[sprite_entry + 1] = 0x80;
+				rom[LevelRomData::SPRITE_BANK_TABLE_OFFSET + LEVEL_NUMBER] = 0x11;
+				writeRatsTag(rom, SPRITE_DATA_OFFSET, SPRITE_DATA_SIZE);
+
+				return rom;
+			}
+
+			std::string fingerprintGlobal(const std::vector<unsigned char>& rom) {
+				return LevelRomData::fingerprintRemainingRom(rom, LevelRomData::getModifiedLevelNumbers(rom));
+			}
+		}
+
+		TEST(LevelRomDataTest, FindsMovedLevelData) {
+			const auto rom{ makeRom() };
+
+			EXPECT_EQ(LevelRomData::getModifiedLevelNumbers(rom), std::vector<int>{ LEVEL_NUMBER });
+
+			const auto blocks{ LevelRomData::getDataBlocks(rom, LEVEL_NUMBER) };
+			ASSERT_TRUE(blocks.has_value());
+			const std::vector<LevelRomData::DataBlock> expected{
+				{ LAYER_1_DATA_OFFSET, LAYER_1_DATA_SIZE },
+				{ SPRITE_DATA_OFFSET, SPRITE_DATA_SIZE }
+			};
+			EXPECT_EQ(blocks.value(), expected);
+		}
+
+		TEST(LevelRomDataTest, LevelDataEditOnlyChangesLevelFingerprint) {
+			const auto rom{ makeRom() };
+			auto edited{ rom };
+			edited[LAYER_1_DATA_OFFSET + 0x10] ^= 0xFF;
+			edited[SPRITE_DATA_OFFSET + 0x4] ^= 0xFF;
+
+			EXPECT_EQ(fingerprintGlobal(edited), fingerprintGlobal(rom));
+			EXPECT_NE(LevelRomData::fingerprintLevel(edited, LEVEL_NUMBER), LevelRomData::fingerprintLevel(rom, LEVEL_NUMBER));
+		}
+
+		TEST(LevelRomDataTest, ExpandedRegionEditOutsideLevelDataForcesFullExport) {
+			const auto rom{ makeRom() };
+			auto edited{ rom };
+			edited[OTHER_EXPANDED_DATA_OFFSET] ^= 0xFF;
+
+			// a different global fingerprint is what makes the next export a full one
+			EXPECT_NE(fingerprintGlobal(edited), fingerprintGlobal(rom));
+			EXPECT_EQ(LevelRomData::fingerprintLevel(edited, LEVEL_NUMBER), LevelRomData::fingerprintLevel(rom, LEVEL_NUMBER));
+		}
+
+		TEST(LevelRomDataTest, OriginalRomEditForcesFullExport) {
+			const auto rom{ makeRom() };
+			auto edited{ rom };
+			edited[0x10000] ^= 0xFF;
+
+			EXPECT_NE(fingerprintGlobal(edited), fingerprintGlobal(rom));
+		}
+
+		TEST(LevelRomDataTest, CommentAndChecksumAreIgnored) {
+			const auto rom{ makeRom() };
+			auto edited{ rom };
+			edited[LevelRomData::ROM_COMMENT_OFFSET] ^= 0xFF;
+			edited[LevelRomData::ROM_CHECKSUM_OFFSET] ^= 0xFF;
+
+			EXPECT_EQ(fingerprintGlobal(edited), fingerprintGlobal(rom));
+		}
+
+		TEST(LevelRomDataTest, DataOfUnmodifiedLevelsIsPartOfGlobalFingerprint) {
+			const auto rom{ makeRom() };
+			auto edited{ rom };
+			// level 0x105 moving back into the original ROM leaves its old data behind in the expanded area
+			const auto layer_1_entry{ LevelRomData::LAYER_1_POINTERS_OFFSET + LEVEL_NUMBER * LevelRomData::LAYER_1_POINTER_SIZE };
+			edited[layer_1_entry + 2] = 0x06;
+			edited[LAYER_1_DATA_OFFSET] ^= 0xFF;
+
+			EXPECT_TRUE(LevelRomData::getModifiedLevelNumbers(edited).empty());
+			EXPECT_NE(fingerprintGlobal(edited), fingerprintGlobal(rom));
+		}
+	}
+}
@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "../insertables/label_index.h"
+
+using namespace callisto;
+
+namespace {
+	constexpr size_t REPETITIONS{ 5 };
+	constexpr size_t LABEL_COUNT{ 10000 };
+	constexpr size_t BLOCK_COUNT{ 1000 };
+	constexpr size_t BLOCK_SIZE{ 0x100 };
+
+	// best of REPETITIONS runs in seconds, the best run is the one least disturbed by everything else on the machine
+	template<typename F>
+	double timeBest(F&& function) {
+		double best{ std::numeric_limits<double>::max() };
+		for (size_t i{ 0 }; i != REPETITIONS; ++i) {
+			const auto start{ std::chrono::steady_clock::now() };
+			function();
+			const std::chrono::duration<double> elapsed{ std::chrono::steady_clock::now() - start };
+			best = std::min(best, elapsed.count());
+		}
+		return best;
+	}
+
+	// what verifyWrittenBlockCoverage did before labels were indexed, every label against every block
+	size_t countCoveredLinear(const std::vector<size_t>& labels, const std::vector<std::pair<size_t, size_t>>& blocks) {
+		size_t covered{ 0 };
+		for (const auto& [start_snes, end_snes] : blocks) {
+			if (std::any_of(labels.begin(), labels.end(), [&](size_t label) {
+				return (label >= start_snes && label < end_snes) || ((label | 0x800000) >= start_snes && (label | 0x800000) < end_snes);
+			})) {
+				++covered;
+			}
+		}
+		return covered;
+	}
+
+	size_t countCoveredIndexed(const std::vector<size_t>& labels, const std::vector<std::pair<size_t, size_t>>& blocks) {
+		const LabelIndex label_index{ labels };
+		size_t covered{ 0 };
+		for (const auto& [start_snes, end_snes] : blocks) {
+			if (label_index.containsAnyIn(start_snes, end_snes)) {
+				++covered;
+			}
+		}
+		return covered;
+	}
+}
+
+// Usage: module_coverage_benchmark, times the freespace coverage check of a large module,
+// LABEL_COUNT labels spread across BLOCK_COUNT written blocks of which every other one holds no label
+int main() {
+	std::mt19937 random{ 1 };
+
+	// blocks in banks $10 and up, one per $200 bytes so there is room between them
+	std::vector<std::pair<size_t, size_t>> blocks{};
+	for (size_t i{ 0 }; i != BLOCK_COUNT; ++i) {
+		const auto start_pc{ 0x80000 + i * 2 * BLOCK_SIZE };
+		const auto start_snes{ ((start_pc << 1) & 0x7F0000) | (start_pc & 0x7FFF) | 0x8000 };
+		blocks.emplace_back(start_snes, start_snes + BLOCK_SIZE);
+	}
+
+	// the worst case for the old check, uncovered blocks had to look at every label before giving up
+	std::vector<size_t> labels{};
+	for (size_t i{ 0 }; i != LABEL_COUNT; ++i) {
+		const auto& [start_snes, end_snes]{ blocks[(random() % (BLOCK_COUNT / 2)) * 2] };
+		labels.push_back(start_snes + random() % (end_snes - start_snes));
+	}
+
+	size_t linear_covered{};
+	size_t indexed_covered{};
+	const auto linear_seconds{ timeBest([&] { linear_covered = countCoveredLinear(labels, blocks); }) };
+	const auto indexed_seconds{ timeBest([&] { indexed_covered = countCoveredIndexed(labels, blocks); }) };
+
+	fmt::print("{} labels, {} written blocks, {} covered\n", LABEL_COUNT, BLOCK_COUNT, indexed_covered);
+	fmt::print("  every label per block: {:>8.3f} ms\n", linear_seconds * 1000.0);
+	fmt::print("  label index:           {:>8.3f} ms ({:.0f}x)\n", indexed_seconds * 1000.0, linear_seconds / indexed_seconds);
+
+	if (linear_covered != indexed_covered) {
+		fmt::print("Mismatch, every label per block found {} covered blocks\n", linear_covered);
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../insertables/write_set.h"
+
+namespace callisto {
+	namespace {
+		constexpr size_t ROM_SIZE{ 0x100000 };
+
+		std::vector<char> makeCleanRom() {
+			std::mt19937 random{ 1 };
+			std::vector<char> rom(ROM_SIZE, 0);
+			// original game in the first 512KB, the expanded area starts out empty
+			for (size_t i{ 0 }; i != 0x80000; ++i) {
+				rom[i] = static_cast<char>(random() & 0xFF);
+			}
+			return rom;
+		}
+
+		// what asar would do for a patch, hook at hook_offset jumping to code placed at freespace_offset
+		struct PatchVersion {
+			size_t hook_offset;
+			size_t freespace_offset;
+			size_t code_size;
+			char code_byte;
+
+			std::vector<std::pair<size_t, size_t>> writtenRanges() const {
+				return { { hook_offset, 4 }, { freespace_offset, code_size } };
+			}
+
+			std::vector<char> applyTo(const std::vector<char>& rom) const {
+				auto patched{ rom };
+				const auto snes_address{ static_cast<uint32_t>(((freespace_offset << 1) & 0x7F0000) | (freespace_offset & 0x7FFF) | 0x8000) };
+				patched[hook_offset] = 0x22;
+				patched[hook_offset + 1] = static_cast<char>(snes_address & 0xFF);
+				patched[hook_offset + 2] = static_cast<char>((snes_address >> 8) & 0xFF);
+				patched[hook_offset + 3] = static_cast<char>((snes_address >> 16) & 0xFF);
+				std::fill(patched.begin() + freespace_offset, patched.begin() + freespace_offset + code_size, code_byte);
+				return patched;
+			}
+		};
+
+		// reinserts a patch whose previous version couldn't be rolled back, the way Patch records it
+		WriteSet reinsertWithoutRollBack(const WriteSet& previous, const std::vector<char>& before, 
+			const std::vector<char>& after, const PatchVersion& version) {
+			EXPECT_TRUE(previous.isIntact(before.data(), before.size()));
+			return WriteSet::capture(before, after, version.writtenRanges()).withEarlier(previous, after);
+		}
+	}
+
+	TEST(WriteSet, RollsBackSingleInsertion) {
+		const auto clean{ makeCleanRom() };
+		const PatchVersion version{ 0x2000, 0x80000, 0x40, 0x11 };
+		auto rom{ version.applyTo(clean) };
+		const auto write_set{ WriteSet::capture(clean, rom, version.writtenRanges()) };
+
+		ASSERT_TRUE(write_set.isIntact(rom.data(), rom.size()));
+		write_set.rollBack(rom.data(), rom.size());
+		EXPECT_EQ(rom, clean);
+	}
+
+	TEST(WriteSet, RemovalAfterReinsertionsWithoutRollBackRestoresCleanRom) {
+		const auto clean{ makeCleanRom() };
+		// every version moves the hook and the code somewhere else, so each leaves bytes the next one doesn't touch
+		const PatchVersion first{ 0x2000, 0x80000, 0x40, 0x11 };
+		const PatchVersion second{ 0x2002, 0x80100, 0x20, 0x22 };
+		const PatchVersion third{ 0x3000, 0x80010, 0x80, 0x33 };
+
+		const auto after_first{ first.applyTo(clean) };
+		const auto first_write_set{ WriteSet::capture(clean, after_first, first.writtenRanges()) };
+
+		const auto after_second{ second.applyTo(after_first) };
+		const auto second_write_set{ reinsertWithoutRollBack(first_write_set, after_first, after_second, second) };
+
+		const auto after_third{ third.applyTo(after_second) };
+		const auto third_write_set{ reinsertWithoutRollBack(second_write_set, after_second, after_third, third) };
+
+		auto removed{ after_third };
+		ASSERT_TRUE(third_write_set.isIntact(removed.data(), removed.size()));
+		third_write_set.rollBack(removed.data(), removed.size());
+		EXPECT_EQ(removed, clean);
+	}
+
+	TEST(WriteSet, WriteSetOfReinsertionAloneLeavesPreviousVersionBehind) {
+		const auto clean{ makeCleanRom() };
+		const PatchVersion first{ 0x2000, 0x80000, 0x40, 0x11 };
+		const PatchVersion second{ 0x2000, 0x80100, 0x20, 0x22 };
+
+		const auto after_first{ first.applyTo(clean) };
+		const auto after_second{ second.applyTo(after_first) };
+		// what used to be recorded, the previous version's hook counts as the original bytes
+		const auto write_set{ WriteSet::capture(after_first, after_second, second.writtenRanges()) };
+
+		auto removed{ after_second };
+		write_set.rollBack(removed.data(), removed.size());
+		EXPECT_NE(removed, clean);
+		EXPECT_EQ(removed, after_first);
+	}
+
+	TEST(WriteSet, CombinedWriteSetSurvivesSaving) {
+		const auto clean{ makeCleanRom() };
+		const PatchVersion first{ 0x2000, 0x80000, 0x40, 0x11 };
+		const PatchVersion second{ 0x2002, 0x80100, 0x20, 0x22 };
+		const auto after_first{ first.applyTo(clean) };
+		const auto after_second{ second.applyTo(after_first) };
+		const auto combined{ reinsertWithoutRollBack(WriteSet::capture(clean, after_first, first.writtenRanges()), 
+			after_first, after_second, second) };
+
+		const auto path{ fs::temp_directory_path() / "callisto_write_set_test.bin" };
+		combined.write(path);
+		const auto read{ WriteSet::read(path) };
+		fs::remove(path);
+
+		ASSERT_TRUE(read.has_value());
+		auto removed{ after_second };
+		ASSERT_TRUE(read.value().isIntact(removed.data(), removed.size()));
+		read.value().rollBack(removed.data(), removed.size());
+		EXPECT_EQ(removed, clean);
+	}
+}
@@ -456,18 +456,6 @@ namespace callisto {
 			return;
 		}
 
-		if (!config->flips_path.isSet()) {
-			showModal("Error", fmt::format("{} not set in configuration files\nCannot package ROM", config->flips_path.name));
-		}
-
-		if (!fs::exists(config->flips_path.getOrThrow())) {
-			showModal("Error", fmt::format(
-				"FLIPS not found at\n    {}\n\nCannot package ROM",
-				config->flips_path.getOrThrow().string())
-			);
-			return;
-		}
-
 		if (!config->clean_rom.isSet()) {
 			showModal("Error", fmt::format("{} not set in configuration files\nCannot package ROM", config->clean_rom.name));
 		}
@@ -492,24 +480,22 @@ namespace callisto {
 			}
 		}
 
-		int exit_code;
+		bool reused;
 		try {
-			exit_code = bp::system(
-				config->flips_path.getOrThrow().string(), "--create", "--bps-delta", config->clean_rom.getOrThrow().string(),
-				config->output_rom.getOrThrow().string(), config->bps_package.getOrThrow().string(), bp::std_out > bp::null
-			);
+			reused = Packager::package({ config }).front().reused;
 		}
 		catch (const std::exception& e) {
 			showModal("Error", fmt::format(
 				"Failed to package ROM with exception:\n{}", e.what()
 			));
+			return;
 		}
 
-		if (exit_code == 0) {
-			showModal("Success", fmt::format("Successfully created package of ROM at\n    {}", config->bps_package.getOrThrow().string()));
+		if (reused) {
+			showModal("Success", fmt::format("Package of ROM at\n    {}\nis already up to date", config->bps_package.getOrThrow().string()));
 		}
 		else {
-			showModal("Error", fmt::format("FLIPS failed to create package of ROM at\n    {}", config->bps_package.getOrThrow().string()));
+			showModal("Success", fmt::format("Successfully created package of ROM at\n    {}", config->bps_package.getOrThrow().string()));
 		}
 	}
 
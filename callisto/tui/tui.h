@@ -31,6 +31,8 @@
 
 #include "../path_util.h"
 
+#include "../packager/packager.h"
+
 #include "../lunar_magic/lunar_magic_wrapper.h"
 
 using namespace ftxui;